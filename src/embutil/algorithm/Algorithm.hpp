@@ -83,6 +83,19 @@ inline constexpr bool isPow2Ce(T aInteger)
 		false;
 }
 
+/// Largest power of 2 that does not exceed `aInteger`, or 0
+template <class T>
+inline T floorPow2(T aInteger)
+{
+	T ret = aInteger > 0 ? 1 : 0;
+
+	while (ret > 0 && ret <= aInteger / 2) {
+		ret *= 2;
+	}
+
+	return ret;
+}
+
 template <class T1, class T2>
 inline void bytewiseMove(T1 *aDst, T2 *aSrc, std::size_t aNbytes = sizeof(T1) > sizeof(T2) ? sizeof(T2) : sizeof(T1))
 {
@@ -0,0 +1,392 @@
+//
+// ByteScan.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_ALGORITHM_BYTESCAN_HPP_
+#define UTILITY_UTILITY_ALGORITHM_BYTESCAN_HPP_
+
+#include "utility/algorithm/Cpu.hpp"
+#include "utility/container/Buffer.hpp"
+#include <algorithm>
+#include <cstdint>
+
+#if UT_AL_X86
+# include <immintrin.h>
+#endif
+
+namespace Ut {
+namespace Al {
+
+enum class ByteScanImplementation {
+	Auto,  ///< The widest one available
+	Scalar,
+	Sse2,  ///< 16 bytes per step. Falls back to `Scalar`, when not available
+	Avx2,  ///< 32 bytes per step. Falls back to `Sse2`, when not available
+};
+
+/// Byte scanning kernels operating on raw memory. Every kernel returns `aSize`,
+/// when nothing is found.
+struct ByteScanKernels {
+	std::size_t (*find)(const std::uint8_t *aData, std::size_t aSize, std::uint8_t aNeedle);
+
+	/// \arg aNeedles 4 needles. Unused ones duplicate the first one
+	std::size_t (*findAny)(const std::uint8_t *aData, std::size_t aSize, const std::uint8_t *aNeedles);
+
+	std::size_t (*count)(const std::uint8_t *aData, std::size_t aSize, std::uint8_t aNeedle);
+
+	/// \returns index of the first differing byte
+	std::size_t (*mismatch)(const std::uint8_t *aLhs, const std::uint8_t *aRhs, std::size_t aSize);
+};
+
+namespace Impl {
+
+inline std::size_t findScalar(const std::uint8_t *aData, std::size_t aSize, std::uint8_t aNeedle)
+{
+	std::size_t i = 0;
+
+	for (; i < aSize && aData[i] != aNeedle; ++i) {
+	}
+
+	return i;
+}
+
+inline std::size_t findAnyScalar(const std::uint8_t *aData, std::size_t aSize, const std::uint8_t *aNeedles)
+{
+	std::size_t i = 0;
+
+	for (; i < aSize; ++i) {
+		const std::uint8_t byte = aData[i];
+
+		if (byte == aNeedles[0] || byte == aNeedles[1] || byte == aNeedles[2] || byte == aNeedles[3]) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+inline std::size_t countScalar(const std::uint8_t *aData, std::size_t aSize, std::uint8_t aNeedle)
+{
+	std::size_t ret = 0;
+
+	for (std::size_t i = 0; i < aSize; ++i) {
+		ret += aData[i] == aNeedle;
+	}
+
+	return ret;
+}
+
+inline std::size_t mismatchScalar(const std::uint8_t *aLhs, const std::uint8_t *aRhs, std::size_t aSize)
+{
+	std::size_t i = 0;
+
+	for (; i < aSize && aLhs[i] == aRhs[i]; ++i) {
+	}
+
+	return i;
+}
+
+#if UT_AL_X86
+
+// SSE2. Unaligned loads, the tail shorter than a vector is handled by scalar code
+
+__attribute__((target("sse2")))
+inline std::size_t findSse2(const std::uint8_t *aData, std::size_t aSize, std::uint8_t aNeedle)
+{
+	const __m128i needle = _mm_set1_epi8(static_cast<char>(aNeedle));
+	std::size_t i = 0;
+
+	for (; i + 16 <= aSize; i += 16) {
+		const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aData + i));
+		const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+
+		if (mask != 0) {
+			return i + __builtin_ctz(mask);
+		}
+	}
+
+	return i + findScalar(aData + i, aSize - i, aNeedle);
+}
+
+__attribute__((target("sse2")))
+inline std::size_t findAnySse2(const std::uint8_t *aData, std::size_t aSize, const std::uint8_t *aNeedles)
+{
+	const __m128i needle0 = _mm_set1_epi8(static_cast<char>(aNeedles[0]));
+	const __m128i needle1 = _mm_set1_epi8(static_cast<char>(aNeedles[1]));
+	const __m128i needle2 = _mm_set1_epi8(static_cast<char>(aNeedles[2]));
+	const __m128i needle3 = _mm_set1_epi8(static_cast<char>(aNeedles[3]));
+	std::size_t i = 0;
+
+	for (; i + 16 <= aSize; i += 16) {
+		const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aData + i));
+		const __m128i match = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(block, needle0), _mm_cmpeq_epi8(block, needle1)),
+			_mm_or_si128(_mm_cmpeq_epi8(block, needle2), _mm_cmpeq_epi8(block, needle3)));
+		const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(match));
+
+		if (mask != 0) {
+			return i + __builtin_ctz(mask);
+		}
+	}
+
+	return i + findAnyScalar(aData + i, aSize - i, aNeedles);
+}
+
+/// Accumulates matches in 8-bit lanes for up to 255 vectors, and then sums
+/// the lanes up with `psadbw`
+__attribute__((target("sse2")))
+inline std::size_t countSse2(const std::uint8_t *aData, std::size_t aSize, std::uint8_t aNeedle)
+{
+	const __m128i needle = _mm_set1_epi8(static_cast<char>(aNeedle));
+	const __m128i zero = _mm_setzero_si128();
+	std::size_t ret = 0;
+	std::size_t i = 0;
+
+	while (i + 16 <= aSize) {
+		const std::size_t nBlocks = std::min<std::size_t>((aSize - i) / 16, 255);
+		__m128i counters = zero;
+
+		for (std::size_t iBlock = 0; iBlock < nBlocks; ++iBlock, i += 16) {
+			const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aData + i));
+			counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(block, needle));
+		}
+
+		const __m128i sums = _mm_sad_epu8(counters, zero);
+		ret += static_cast<std::size_t>(_mm_cvtsi128_si32(sums))
+			+ static_cast<std::size_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+	}
+
+	return ret + countScalar(aData + i, aSize - i, aNeedle);
+}
+
+__attribute__((target("sse2")))
+inline std::size_t mismatchSse2(const std::uint8_t *aLhs, const std::uint8_t *aRhs, std::size_t aSize)
+{
+	std::size_t i = 0;
+
+	for (; i + 16 <= aSize; i += 16) {
+		const __m128i lhs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aLhs + i));
+		const __m128i rhs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aRhs + i));
+		const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(lhs, rhs)));
+
+		if (mask != 0xFFFF) {
+			return i + __builtin_ctz(~mask);
+		}
+	}
+
+	return i + mismatchScalar(aLhs + i, aRhs + i, aSize - i);
+}
+
+// AVX2
+
+__attribute__((target("avx2")))
+inline std::size_t findAvx2(const std::uint8_t *aData, std::size_t aSize, std::uint8_t aNeedle)
+{
+	const __m256i needle = _mm256_set1_epi8(static_cast<char>(aNeedle));
+	std::size_t i = 0;
+
+	for (; i + 32 <= aSize; i += 32) {
+		const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(aData + i));
+		const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+
+		if (mask != 0) {
+			return i + __builtin_ctz(mask);
+		}
+	}
+
+	return i + findScalar(aData + i, aSize - i, aNeedle);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t findAnyAvx2(const std::uint8_t *aData, std::size_t aSize, const std::uint8_t *aNeedles)
+{
+	const __m256i needle0 = _mm256_set1_epi8(static_cast<char>(aNeedles[0]));
+	const __m256i needle1 = _mm256_set1_epi8(static_cast<char>(aNeedles[1]));
+	const __m256i needle2 = _mm256_set1_epi8(static_cast<char>(aNeedles[2]));
+	const __m256i needle3 = _mm256_set1_epi8(static_cast<char>(aNeedles[3]));
+	std::size_t i = 0;
+
+	for (; i + 32 <= aSize; i += 32) {
+		const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(aData + i));
+		const __m256i match = _mm256_or_si256(
+			_mm256_or_si256(_mm256_cmpeq_epi8(block, needle0), _mm256_cmpeq_epi8(block, needle1)),
+			_mm256_or_si256(_mm256_cmpeq_epi8(block, needle2), _mm256_cmpeq_epi8(block, needle3)));
+		const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(match));
+
+		if (mask != 0) {
+			return i + __builtin_ctz(mask);
+		}
+	}
+
+	return i + findAnyScalar(aData + i, aSize - i, aNeedles);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t countAvx2(const std::uint8_t *aData, std::size_t aSize, std::uint8_t aNeedle)
+{
+	const __m256i needle = _mm256_set1_epi8(static_cast<char>(aNeedle));
+	const __m256i zero = _mm256_setzero_si256();
+	std::size_t ret = 0;
+	std::size_t i = 0;
+
+	while (i + 32 <= aSize) {
+		const std::size_t nBlocks = std::min<std::size_t>((aSize - i) / 32, 255);
+		__m256i counters = zero;
+
+		for (std::size_t iBlock = 0; iBlock < nBlocks; ++iBlock, i += 32) {
+			const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(aData + i));
+			counters = _mm256_sub_epi8(counters, _mm256_cmpeq_epi8(block, needle));
+		}
+
+		std::uint64_t sums[4];
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(sums), _mm256_sad_epu8(counters, zero));
+		ret += static_cast<std::size_t>(sums[0] + sums[1] + sums[2] + sums[3]);
+	}
+
+	return ret + countScalar(aData + i, aSize - i, aNeedle);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t mismatchAvx2(const std::uint8_t *aLhs, const std::uint8_t *aRhs, std::size_t aSize)
+{
+	std::size_t i = 0;
+
+	for (; i + 32 <= aSize; i += 32) {
+		const __m256i lhs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(aLhs + i));
+		const __m256i rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(aRhs + i));
+		const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs, rhs)));
+
+		if (mask != 0xFFFFFFFF) {
+			return i + __builtin_ctz(~mask);
+		}
+	}
+
+	return i + mismatchScalar(aLhs + i, aRhs + i, aSize - i);
+}
+
+#endif  // UT_AL_X86
+
+inline ByteScanImplementation resolveByteScanImplementation(ByteScanImplementation aImplementation)
+{
+	const CpuFeatures &features = cpuFeatures();
+
+	if ((aImplementation == ByteScanImplementation::Auto || aImplementation == ByteScanImplementation::Avx2)
+			&& features.avx2) {
+		return ByteScanImplementation::Avx2;
+	} else if (aImplementation != ByteScanImplementation::Scalar && features.sse2) {
+		return ByteScanImplementation::Sse2;
+	}
+
+	return ByteScanImplementation::Scalar;
+}
+
+}  // namespace Impl
+
+/// \returns kernels for `aImplementation`. The CPU is probed once, later
+/// calls only cost a lookup.
+inline const ByteScanKernels &byteScanKernels(ByteScanImplementation aImplementation = ByteScanImplementation::Auto)
+{
+	static const ByteScanKernels kScalar{Impl::findScalar, Impl::findAnyScalar, Impl::countScalar,
+		Impl::mismatchScalar};
+#if UT_AL_X86
+	static const ByteScanKernels kSse2{Impl::findSse2, Impl::findAnySse2, Impl::countSse2, Impl::mismatchSse2};
+	static const ByteScanKernels kAvx2{Impl::findAvx2, Impl::findAnyAvx2, Impl::countAvx2, Impl::mismatchAvx2};
+	static const ByteScanImplementation kAuto = Impl::resolveByteScanImplementation(ByteScanImplementation::Auto);
+	const ByteScanImplementation implementation = aImplementation == ByteScanImplementation::Auto ? kAuto :
+		Impl::resolveByteScanImplementation(aImplementation);
+
+	switch (implementation) {
+		case ByteScanImplementation::Avx2:
+			return kAvx2;
+
+		case ByteScanImplementation::Sse2:
+			return kSse2;
+
+		default:
+			break;
+	}
+#else
+	(void)aImplementation;
+#endif
+
+	return kScalar;
+}
+
+namespace Impl {
+
+template <class T>
+inline const std::uint8_t *bytesOf(const Ut::Ct::Buffer<T> &aBuffer)
+{
+	static_assert(sizeof(typename Ut::Ct::Buffer<T>::InterpType) == 1, "Byte buffers only");
+
+	return reinterpret_cast<const std::uint8_t *>(aBuffer.data());
+}
+
+}  // namespace Impl
+
+/// \returns position of the first `aNeedle` in `aBuffer`, or `aBuffer.size()`
+template <class T>
+inline std::size_t find(const Ut::Ct::Buffer<T> &aBuffer, std::uint8_t aNeedle)
+{
+	return byteScanKernels().find(Impl::bytesOf(aBuffer), aBuffer.size(), aNeedle);
+}
+
+/// \returns position of the first byte matching any of up to 4 needles, or
+/// `aBuffer.size()`
+template <class T, class ...Ts>
+inline std::size_t findAny(const Ut::Ct::Buffer<T> &aBuffer, std::uint8_t aNeedle, Ts ...aNeedles)
+{
+	static_assert(sizeof...(Ts) < 4, "Up to 4 needles are supported");
+	std::uint8_t needles[4] = {aNeedle, static_cast<std::uint8_t>(aNeedles)...};
+
+	for (std::size_t i = 1 + sizeof...(Ts); i < 4; ++i) {
+		needles[i] = aNeedle;
+	}
+
+	return byteScanKernels().findAny(Impl::bytesOf(aBuffer), aBuffer.size(), needles);
+}
+
+/// Number of `aNeedle` occurrences in `aBuffer`
+template <class T>
+inline std::size_t count(const Ut::Ct::Buffer<T> &aBuffer, std::uint8_t aNeedle)
+{
+	return byteScanKernels().count(Impl::bytesOf(aBuffer), aBuffer.size(), aNeedle);
+}
+
+/// \returns position of the first differing byte, or the size of the shorter
+/// buffer
+template <class T, class U>
+inline std::size_t mismatch(const Ut::Ct::Buffer<T> &aLhs, const Ut::Ct::Buffer<U> &aRhs)
+{
+	return byteScanKernels().mismatch(Impl::bytesOf(aLhs), Impl::bytesOf(aRhs), std::min(aLhs.size(), aRhs.size()));
+}
+
+template <class T, class U>
+inline bool equal(const Ut::Ct::Buffer<T> &aLhs, const Ut::Ct::Buffer<U> &aRhs)
+{
+	return aLhs.size() == aRhs.size() && Ut::Al::mismatch(aLhs, aRhs) == aLhs.size();
+}
+
+/// Lexicographical comparison of bytes treated as unsigned, like `memcmp`
+///
+/// \returns negative value, 0, or positive value, if `aLhs` is less than,
+/// equal to, or greater than `aRhs`
+template <class T, class U>
+inline int compare(const Ut::Ct::Buffer<T> &aLhs, const Ut::Ct::Buffer<U> &aRhs)
+{
+	const std::size_t position = Ut::Al::mismatch(aLhs, aRhs);
+
+	if (position < aLhs.size() && position < aRhs.size()) {
+		return static_cast<int>(Impl::bytesOf(aLhs)[position]) - static_cast<int>(Impl::bytesOf(aRhs)[position]);
+	}
+
+	return aLhs.size() < aRhs.size() ? -1 : aLhs.size() > aRhs.size() ? 1 : 0;
+}
+
+}  // namespace Al
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_ALGORITHM_BYTESCAN_HPP_
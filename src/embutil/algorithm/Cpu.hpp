@@ -0,0 +1,78 @@
+//
+// Cpu.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_ALGORITHM_CPU_HPP_
+#define UTILITY_UTILITY_ALGORITHM_CPU_HPP_
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+# define UT_AL_X86 1
+# include <cpuid.h>
+#else
+# define UT_AL_X86 0
+#endif
+
+namespace Ut {
+namespace Al {
+
+/// Instruction set extensions available at runtime. Algorithms having an
+/// accelerated path check these once, and fall back to portable code on
+/// other CPUs and architectures.
+struct CpuFeatures {
+	bool sse2;
+	bool sse42;
+	bool avx2;  ///< Also implies that the OS preserves YMM registers
+};
+
+namespace Impl {
+
+inline CpuFeatures detectCpuFeatures()
+{
+	CpuFeatures features{false, false, false};
+#if UT_AL_X86
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+		return features;
+	}
+
+	features.sse2 = (edx & bit_SSE2) != 0;
+	features.sse42 = (ecx & bit_SSE4_2) != 0;
+	bool ymmEnabled = false;
+
+	if ((ecx & bit_OSXSAVE) != 0 && (ecx & bit_AVX) != 0) {
+		unsigned int xcr0 = 0;
+		unsigned int xcr0High = 0;
+		__asm__ volatile ("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+		(void)xcr0High;
+		ymmEnabled = (xcr0 & 0x6) == 0x6;  // XMM and YMM state
+	}
+
+	if (ymmEnabled && __get_cpuid_max(0, nullptr) >= 7) {
+		__cpuid_count(7, 0, eax, ebx, ecx, edx);
+		features.avx2 = (ebx & bit_AVX2) != 0;
+	}
+#endif
+
+	return features;
+}
+
+}  // namespace Impl
+
+inline const CpuFeatures &cpuFeatures()
+{
+	static const CpuFeatures features = Impl::detectCpuFeatures();
+
+	return features;
+}
+
+}  // namespace Al
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_ALGORITHM_CPU_HPP_
@@ -0,0 +1,230 @@
+//
+// Crc.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_ALGORITHM_CRC_HPP_
+#define UTILITY_UTILITY_ALGORITHM_CRC_HPP_
+
+#include "utility/algorithm/Cpu.hpp"
+#include "utility/container/Buffer.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#if UT_AL_X86
+# include <nmmintrin.h>
+#endif
+
+namespace Ut {
+namespace Al {
+
+enum class CrcImplementation {
+	Auto,  ///< The fastest one available
+	Bytewise,  ///< One table lookup per byte
+	Slicing8,  ///< 8 independent table lookups per 8 bytes
+	Hardware,  ///< SSE4.2 `crc32` instruction. CRC32C only, falls back to `Slicing8` otherwise
+};
+
+namespace Impl {
+
+/// Lookup tables for reflected CRC-32 algorithms. `table[0]` is the classic
+/// bytewise table, `table[k][i]` is the CRC of byte `i` followed by `k` zero
+/// bytes, which is what slicing-by-8 needs.
+template <std::uint32_t kPolynomial>
+struct CrcTables {
+	CrcTables()
+	{
+		for (std::uint32_t i = 0; i < 256; ++i) {
+			std::uint32_t crc = i;
+
+			for (int bit = 0; bit < 8; ++bit) {
+				crc = (crc >> 1) ^ (kPolynomial & (0 - (crc & 1)));
+			}
+
+			table[0][i] = crc;
+		}
+
+		for (std::size_t k = 1; k < table.size(); ++k) {
+			for (std::size_t i = 0; i < 256; ++i) {
+				table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+			}
+		}
+	}
+
+	/// Generated once on the first use, which keeps 8 KiB per polynomial out of
+	/// flash images that never compute CRCs
+	static const CrcTables &instance()
+	{
+		static const CrcTables tables;
+
+		return tables;
+	}
+
+	std::array<std::array<std::uint32_t, 256>, 8> table;
+};
+
+template <std::uint32_t kPolynomial>
+inline std::uint32_t crcUpdateBytewise(std::uint32_t aState, const std::uint8_t *aData, std::size_t aSize)
+{
+	const auto &table = CrcTables<kPolynomial>::instance().table[0];
+
+	for (std::size_t i = 0; i < aSize; ++i) {
+		aState = (aState >> 8) ^ table[(aState ^ aData[i]) & 0xFF];
+	}
+
+	return aState;
+}
+
+template <std::uint32_t kPolynomial>
+inline std::uint32_t crcUpdateSlicing8(std::uint32_t aState, const std::uint8_t *aData, std::size_t aSize)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	const auto &table = CrcTables<kPolynomial>::instance().table;
+
+	for (; aSize >= 8; aSize -= 8, aData += 8) {
+		std::uint32_t low;
+		std::uint32_t high;
+		memcpy(&low, aData, sizeof(low));
+		memcpy(&high, aData + 4, sizeof(high));
+		low ^= aState;
+		aState = table[7][low & 0xFF] ^ table[6][(low >> 8) & 0xFF] ^ table[5][(low >> 16) & 0xFF]
+			^ table[4][low >> 24] ^ table[3][high & 0xFF] ^ table[2][(high >> 8) & 0xFF]
+			^ table[1][(high >> 16) & 0xFF] ^ table[0][high >> 24];
+	}
+#endif
+
+	return crcUpdateBytewise<kPolynomial>(aState, aData, aSize);
+}
+
+#if UT_AL_X86
+
+__attribute__((target("sse4.2")))
+inline std::uint32_t crc32cUpdateHardware(std::uint32_t aState, const std::uint8_t *aData, std::size_t aSize)
+{
+# if defined(__x86_64__)
+	std::uint64_t state = aState;
+
+	for (; aSize >= 8; aSize -= 8, aData += 8) {
+		std::uint64_t word;
+		memcpy(&word, aData, sizeof(word));
+		state = _mm_crc32_u64(state, word);
+	}
+
+	aState = static_cast<std::uint32_t>(state);
+# endif
+
+	for (; aSize >= 4; aSize -= 4, aData += 4) {
+		std::uint32_t word;
+		memcpy(&word, aData, sizeof(word));
+		aState = _mm_crc32_u32(aState, word);
+	}
+
+	for (; aSize > 0; --aSize, ++aData) {
+		aState = _mm_crc32_u8(aState, *aData);
+	}
+
+	return aState;
+}
+
+#endif
+
+}  // namespace Impl
+
+/// Streaming reflected CRC-32 calculator
+///
+/// \tparam kPolynomial reversed representation of the polynomial
+template <std::uint32_t kPolynomial>
+class Crc {
+public:
+	explicit Crc(CrcImplementation aImplementation = CrcImplementation::Auto) :
+		state{kInitialState},
+		implementation{resolve(aImplementation)}
+	{
+	}
+
+	/// Continues the calculation over `aData`
+	Crc &update(Ut::Ct::ConstMemoryBuffer aData)
+	{
+		const auto *data = static_cast<const std::uint8_t *>(aData.data());
+
+		switch (implementation) {
+			case CrcImplementation::Bytewise:
+				state = Impl::crcUpdateBytewise<kPolynomial>(state, data, aData.size());
+
+				break;
+#if UT_AL_X86
+			case CrcImplementation::Hardware:
+				state = Impl::crc32cUpdateHardware(state, data, aData.size());
+
+				break;
+#endif
+			default:
+				state = Impl::crcUpdateSlicing8<kPolynomial>(state, data, aData.size());
+
+				break;
+		}
+
+		return *this;
+	}
+
+	/// CRC of the data passed so far
+	std::uint32_t value() const
+	{
+		return state ^ kInitialState;
+	}
+
+	void reset()
+	{
+		state = kInitialState;
+	}
+
+	CrcImplementation selectedImplementation() const
+	{
+		return implementation;
+	}
+
+	static std::uint32_t compute(Ut::Ct::ConstMemoryBuffer aData,
+		CrcImplementation aImplementation = CrcImplementation::Auto)
+	{
+		return Crc{aImplementation}.update(aData).value();
+	}
+
+private:
+	static constexpr std::uint32_t kInitialState = 0xFFFFFFFF;
+	static constexpr std::uint32_t kCrc32cPolynomial = 0x82F63B78;
+
+	static CrcImplementation resolve(CrcImplementation aImplementation)
+	{
+		if (aImplementation == CrcImplementation::Auto || aImplementation == CrcImplementation::Hardware) {
+			return kPolynomial == kCrc32cPolynomial && UT_AL_X86 && cpuFeatures().sse42 ?
+				CrcImplementation::Hardware :
+				CrcImplementation::Slicing8;
+		}
+
+		return aImplementation;
+	}
+
+private:
+	std::uint32_t state;
+	CrcImplementation implementation;
+};
+
+template <std::uint32_t kPolynomial>
+constexpr std::uint32_t Crc<kPolynomial>::kInitialState;
+
+template <std::uint32_t kPolynomial>
+constexpr std::uint32_t Crc<kPolynomial>::kCrc32cPolynomial;
+
+/// CRC-32 (IEEE 802.3), the same as `OhDebug::crc_table`
+using Crc32 = Crc<0xEDB88320>;
+
+/// CRC-32C (Castagnoli), accelerated with SSE4.2 where available
+using Crc32c = Crc<0x82F63B78>;
+
+}  // namespace Al
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_ALGORITHM_CRC_HPP_
@@ -0,0 +1,439 @@
+//
+// Framing.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_ALGORITHM_FRAMING_HPP_
+#define UTILITY_UTILITY_ALGORITHM_FRAMING_HPP_
+
+#include "utility/algorithm/ByteScan.hpp"
+#include "utility/container/Buffer.hpp"
+#include "utility/container/BufferStream.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Ut {
+namespace Al {
+
+struct FrameDecoderStatistics {
+	std::size_t nFrames;  ///< Frames handed to the callback
+	std::size_t nOverflows;  ///< Frames dropped for not fitting in the decoder's buffer
+	std::size_t nMalformed;  ///< Frames dropped for violating the encoding
+};
+
+/// Upper bound of the COBS-encoded size of a `aSize`-byte frame, the
+/// delimiter included
+constexpr std::size_t cobsEncodedSizeBound(std::size_t aSize)
+{
+	return aSize + aSize / 254 + 2;
+}
+
+/// Upper bound of the SLIP-encoded size of a `aSize`-byte frame, the
+/// delimiter included
+constexpr std::size_t slipEncodedSizeBound(std::size_t aSize)
+{
+	return 2 * aSize + 1;
+}
+
+/// Consistent Overhead Byte Stuffing encoder. Encodes one frame, which may
+/// be supplied in chunks, into a caller-provided buffer. The frame gets
+/// terminated with a 0 delimiter.
+///
+/// Failures are sticky the same way as in `BufferWriter`.
+class CobsEncoder {
+public:
+	/// \arg aDestination see `cobsEncodedSizeBound`
+	explicit CobsEncoder(Ut::Ct::MemoryBuffer aDestination) :
+		writer{aDestination},
+		codeSlot{nullptr},
+		nBlockBytes{0}
+	{
+		openBlock();
+	}
+
+	/// Appends `aChunk` to the frame
+	bool update(Ut::Ct::ConstMemoryBuffer aChunk)
+	{
+		while (aChunk.size() > 0 && writer.ok()) {
+			const std::size_t nNonzero = find(aChunk, 0);
+			const std::size_t nCopy = std::min<std::size_t>(nNonzero, kMaxBlockBytes - nBlockBytes);
+			writer.writeBytes(aChunk.asSlice(0, nCopy));
+			nBlockBytes += nCopy;
+
+			if (nCopy < nNonzero || nBlockBytes == kMaxBlockBytes) {
+				closeBlock();  // Full block, implies no zero
+				aChunk.slice(nCopy);
+			} else if (nNonzero < aChunk.size()) {
+				closeBlock();  // Zero is encoded by the block length
+				aChunk.slice(nNonzero + 1);
+			} else {
+				break;
+			}
+		}
+
+		return writer.ok();
+	}
+
+	/// Terminates the frame
+	///
+	/// \returns the encoded frame, or an empty buffer with `nullptr` data, if
+	/// the destination has not been sufficient
+	Ut::Ct::ConstMemoryBuffer finish()
+	{
+		if (codeSlot != nullptr) {
+			*codeSlot = static_cast<std::uint8_t>(nBlockBytes + 1);
+			codeSlot = nullptr;
+			writer.write<Ut::Ct::Endianness::Little, std::uint8_t>(0);
+		}
+
+		return writer.ok() ? writer.written() : Ut::Ct::ConstMemoryBuffer{nullptr, 0};
+	}
+
+private:
+	static constexpr std::size_t kMaxBlockBytes = 254;
+
+	void openBlock()
+	{
+		codeSlot = static_cast<std::uint8_t *>(writer.reserve(1).data());
+		nBlockBytes = 0;
+	}
+
+	void closeBlock()
+	{
+		if (codeSlot != nullptr) {
+			*codeSlot = static_cast<std::uint8_t>(nBlockBytes + 1);
+		}
+
+		openBlock();
+	}
+
+private:
+	Ut::Ct::BufferWriter writer;
+	std::uint8_t *codeSlot;  ///< Code byte of the current block, filled in when the block is closed
+	std::size_t nBlockBytes;
+};
+
+/// Streaming COBS decoder. Accepts the input in chunks of arbitrary size,
+/// and hands out every complete frame to a callback.
+///
+/// Delimiters are found with the vectorized `Ut::Al::find`, and the data
+/// between code bytes is copied in runs. A frame consisting of a single
+/// block (shorter than 254 bytes and containing no zeros), which arrives
+/// within one chunk, is handed out as a view of the input without copying.
+///
+/// \tparam kMaxFrameSize size of the internal buffer which frames are
+/// decoded into. Longer frames are dropped.
+template <std::size_t kMaxFrameSize>
+class CobsDecoder {
+public:
+	CobsDecoder() :
+		decoderStatistics{0, 0, 0}
+	{
+		reset();
+	}
+
+	/// \arg aOnFrame callable accepting `Ut::Ct::ConstMemoryBuffer`. The frame
+	/// is only valid for the duration of the call
+	template <class CallbackType>
+	void feed(Ut::Ct::ConstMemoryBuffer aChunk, CallbackType &&aOnFrame)
+	{
+		while (aChunk.size() > 0) {
+			const std::size_t delimiter = find(aChunk, 0);
+			const Ut::Ct::ConstMemoryBuffer span = aChunk.asSlice(0, delimiter);
+
+			if (delimiter < aChunk.size() && isSingleBlock(span)) {
+				++decoderStatistics.nFrames;
+				aOnFrame(span.asSlice(1));
+			} else {
+				decodeSpan(span);
+
+				if (delimiter == aChunk.size()) {
+					break;
+				}
+
+				finishFrame(aOnFrame);
+			}
+
+			aChunk.slice(delimiter + 1);
+		}
+	}
+
+	/// Drops the partially received frame
+	void reset()
+	{
+		nFrameBytes = 0;
+		nBlockRemaining = 0;
+		zeroPending = false;
+		inFrame = false;
+		dropping = false;
+	}
+
+	const FrameDecoderStatistics &statistics() const
+	{
+		return decoderStatistics;
+	}
+
+private:
+	bool isSingleBlock(Ut::Ct::ConstMemoryBuffer aSpan) const
+	{
+		return !inFrame && !dropping && aSpan.size() > 0 && aSpan.size() <= kMaxFrameSize + 1
+			&& static_cast<const std::uint8_t *>(aSpan.data())[0] == aSpan.size();
+	}
+
+	/// Decodes bytes lying between delimiters
+	void decodeSpan(Ut::Ct::ConstMemoryBuffer aSpan)
+	{
+		const auto *data = static_cast<const std::uint8_t *>(aSpan.data());
+		std::size_t position = 0;
+
+		while (position < aSpan.size() && !dropping) {
+			if (nBlockRemaining == 0) {
+				const std::uint8_t code = data[position++];
+
+				if (zeroPending) {
+					append(&kZero, 1);
+				}
+
+				inFrame = true;
+				nBlockRemaining = code - 1U;
+				zeroPending = code != 0xFF;
+			} else {
+				const std::size_t nCopy = std::min(nBlockRemaining, aSpan.size() - position);
+				append(data + position, nCopy);
+				position += nCopy;
+				nBlockRemaining -= nCopy;
+			}
+		}
+	}
+
+	template <class CallbackType>
+	void finishFrame(CallbackType &aOnFrame)
+	{
+		if (!dropping && inFrame) {
+			if (nBlockRemaining != 0) {
+				++decoderStatistics.nMalformed;  // The delimiter has cut the block short
+			} else {
+				++decoderStatistics.nFrames;
+				aOnFrame(Ut::Ct::ConstMemoryBuffer{frame.data(), nFrameBytes});
+			}
+		}
+
+		reset();
+	}
+
+	void append(const std::uint8_t *aData, std::size_t aSize)
+	{
+		if (aSize > kMaxFrameSize - nFrameBytes) {
+			++decoderStatistics.nOverflows;
+			dropping = true;
+
+			return;
+		}
+
+		memcpy(frame.data() + nFrameBytes, aData, aSize);
+		nFrameBytes += aSize;
+	}
+
+private:
+	static constexpr std::uint8_t kZero = 0;
+
+	std::array<std::uint8_t, kMaxFrameSize> frame;
+	std::size_t nFrameBytes;
+	std::size_t nBlockRemaining;  ///< Data bytes of the current block yet to be received
+	bool zeroPending;  ///< The previous block implies a zero, unless it turns out to be the last one
+	bool inFrame;  ///< At least one code byte has been received
+	bool dropping;  ///< Skipping the rest of an overflown frame
+	FrameDecoderStatistics decoderStatistics;
+};
+
+template <std::size_t kMaxFrameSize>
+constexpr std::uint8_t CobsDecoder<kMaxFrameSize>::kZero;
+
+namespace Impl {
+
+constexpr std::uint8_t kSlipEnd = 0xC0;
+constexpr std::uint8_t kSlipEsc = 0xDB;
+constexpr std::uint8_t kSlipEscEnd = 0xDC;
+constexpr std::uint8_t kSlipEscEsc = 0xDD;
+
+}  // namespace Impl
+
+/// SLIP (RFC 1055) encoder. Encodes one frame, which may be supplied in
+/// chunks, into a caller-provided buffer. The frame gets terminated with an
+/// END byte. Runs of bytes which need no escaping are found with the
+/// vectorized `Ut::Al::findAny`, and copied at once.
+///
+/// Failures are sticky the same way as in `BufferWriter`.
+class SlipEncoder {
+public:
+	/// \arg aDestination see `slipEncodedSizeBound`
+	explicit SlipEncoder(Ut::Ct::MemoryBuffer aDestination) :
+		writer{aDestination}
+	{
+	}
+
+	/// Appends `aChunk` to the frame
+	bool update(Ut::Ct::ConstMemoryBuffer aChunk)
+	{
+		while (aChunk.size() > 0 && writer.ok()) {
+			const std::size_t special = findAny(aChunk, Impl::kSlipEnd, Impl::kSlipEsc);
+			writer.writeBytes(aChunk.asSlice(0, special));
+
+			if (special == aChunk.size()) {
+				break;
+			}
+
+			const std::uint8_t byte = static_cast<const std::uint8_t *>(aChunk.data())[special];
+			writer.writeFields(Impl::kSlipEsc, byte == Impl::kSlipEnd ? Impl::kSlipEscEnd : Impl::kSlipEscEsc);
+			aChunk.slice(special + 1);
+		}
+
+		return writer.ok();
+	}
+
+	/// Terminates the frame
+	///
+	/// \returns the encoded frame, or an empty buffer with `nullptr` data, if
+	/// the destination has not been sufficient
+	Ut::Ct::ConstMemoryBuffer finish()
+	{
+		writer.write(Impl::kSlipEnd);
+
+		return writer.ok() ? writer.written() : Ut::Ct::ConstMemoryBuffer{nullptr, 0};
+	}
+
+private:
+	Ut::Ct::BufferWriter writer;
+};
+
+/// Streaming SLIP decoder, see `CobsDecoder`. A frame containing no escape
+/// sequences, which arrives within one chunk, is handed out as a view of
+/// the input without copying. Empty frames, e.g. produced by senders
+/// which put END on both sides of a frame, are skipped.
+template <std::size_t kMaxFrameSize>
+class SlipDecoder {
+public:
+	SlipDecoder() :
+		decoderStatistics{0, 0, 0}
+	{
+		reset();
+	}
+
+	/// \arg aOnFrame callable accepting `Ut::Ct::ConstMemoryBuffer`. The frame
+	/// is only valid for the duration of the call
+	template <class CallbackType>
+	void feed(Ut::Ct::ConstMemoryBuffer aChunk, CallbackType &&aOnFrame)
+	{
+		while (aChunk.size() > 0) {
+			const std::size_t end = find(aChunk, Impl::kSlipEnd);
+			const Ut::Ct::ConstMemoryBuffer span = aChunk.asSlice(0, end);
+
+			if (end < aChunk.size() && nFrameBytes == 0 && !escapePending && !dropping
+					&& find(span, Impl::kSlipEsc) == span.size()) {
+				if (span.size() > 0) {
+					++decoderStatistics.nFrames;
+					aOnFrame(span);
+				}
+			} else {
+				decodeSpan(span);
+
+				if (end == aChunk.size()) {
+					break;
+				}
+
+				finishFrame(aOnFrame);
+			}
+
+			aChunk.slice(end + 1);
+		}
+	}
+
+	/// Drops the partially received frame
+	void reset()
+	{
+		nFrameBytes = 0;
+		escapePending = false;
+		dropping = false;
+	}
+
+	const FrameDecoderStatistics &statistics() const
+	{
+		return decoderStatistics;
+	}
+
+private:
+	/// Decodes bytes lying between END delimiters
+	void decodeSpan(Ut::Ct::ConstMemoryBuffer aSpan)
+	{
+		while (aSpan.size() > 0 && !dropping) {
+			const auto *data = static_cast<const std::uint8_t *>(aSpan.data());
+
+			if (escapePending) {
+				escapePending = false;
+
+				if (data[0] != Impl::kSlipEscEnd && data[0] != Impl::kSlipEscEsc) {
+					++decoderStatistics.nMalformed;
+					dropping = true;
+
+					return;
+				}
+
+				const std::uint8_t byte = data[0] == Impl::kSlipEscEnd ? Impl::kSlipEnd : Impl::kSlipEsc;
+				append(&byte, 1);
+				aSpan.slice(1);
+			} else {
+				const std::size_t escape = find(aSpan, Impl::kSlipEsc);
+				append(data, escape);
+				escapePending = escape < aSpan.size();
+				aSpan.slice(std::min(escape + 1, aSpan.size()));
+			}
+		}
+	}
+
+	template <class CallbackType>
+	void finishFrame(CallbackType &aOnFrame)
+	{
+		if (!dropping) {
+			if (escapePending) {
+				++decoderStatistics.nMalformed;  // ESC END
+			} else if (nFrameBytes > 0) {
+				++decoderStatistics.nFrames;
+				aOnFrame(Ut::Ct::ConstMemoryBuffer{frame.data(), nFrameBytes});
+			}
+		}
+
+		reset();
+	}
+
+	void append(const std::uint8_t *aData, std::size_t aSize)
+	{
+		if (aSize > kMaxFrameSize - nFrameBytes) {
+			++decoderStatistics.nOverflows;
+			dropping = true;
+
+			return;
+		}
+
+		if (aSize > 0) {
+			memcpy(frame.data() + nFrameBytes, aData, aSize);
+			nFrameBytes += aSize;
+		}
+	}
+
+private:
+	std::array<std::uint8_t, kMaxFrameSize> frame;
+	std::size_t nFrameBytes;
+	bool escapePending;  ///< The previous chunk has ended with ESC
+	bool dropping;  ///< Skipping the rest of an overflown or malformed frame
+	FrameDecoderStatistics decoderStatistics;
+};
+
+}  // namespace Al
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_ALGORITHM_FRAMING_HPP_
@@ -0,0 +1,211 @@
+//
+// BlockingFixedSizeQueue.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_CONTAINER_BLOCKINGFIXEDSIZEQUEUE_HPP_
+#define UTILITY_UTILITY_CONTAINER_BLOCKINGFIXEDSIZEQUEUE_HPP_
+
+#include "utility/container/FixedSizeQueue.hpp"
+#include "utility/snippet/SemaphoreTypeInvokeSelector.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Ut {
+namespace Ct {
+
+/// Wraps a thread-safe queue, and parks producers on a full queue, and
+/// consumers on an empty queue.
+///
+/// A side registers itself as waiting before it parks, and then re-checks the
+/// queue. The opposite side only signals the semaphore, when there is a
+/// registered waiter, i.e. when the queue has transitioned from empty to
+/// non-empty (or from full to not-full) while someone was waiting. Otherwise,
+/// pushes and pops do not touch the semaphores at all.
+///
+/// A semaphore may be signaled after the waiter has already succeeded on its
+/// re-check. The waiter handles the resulting spurious wake-up by retrying.
+///
+/// \tparam SemaphoreType Must provide acquire, release, and timed acquire
+/// methods recognized by `Ut::Sn::SemaphoreTypeInvokeSelector`. Counting
+/// semaphores are preferable, when there are more than 1 producer or consumer.
+/// \tparam QueueType thread-safe queue exposing `tryPush` and `tryPop`, e.g.
+/// `SpscFixedSizeQueue` (default) or `MpmcFixedSizeQueue`.
+template <class T, std::size_t N, class SemaphoreType, class QueueType = SpscFixedSizeQueue<T, N>>
+class BlockingFixedSizeQueue {
+public:
+	bool tryPush(const T &aInstance)
+	{
+		if (queue.tryPush(aInstance)) {
+			notify(nWaitingConsumers, notEmpty);
+
+			return true;
+		}
+
+		return false;
+	}
+
+	bool tryPop(T &ret)
+	{
+		if (queue.tryPop(ret)) {
+			notify(nWaitingProducers, notFull);
+
+			return true;
+		}
+
+		return false;
+	}
+
+	/// Blocks while the queue is full
+	void push(const T &aInstance)
+	{
+		while (!tryPush(aInstance)) {
+			if (registerWaiter(nWaitingProducers, [this, &aInstance]() {return tryPush(aInstance);})) {
+				break;
+			}
+
+			Ut::Sn::SemaphoreTypeInvokeSelector::acquire(notFull);
+			unregisterWaiter(nWaitingProducers);
+		}
+	}
+
+	/// Blocks while the queue is empty
+	void pop(T &ret)
+	{
+		while (!tryPop(ret)) {
+			if (registerWaiter(nWaitingConsumers, [this, &ret]() {return tryPop(ret);})) {
+				break;
+			}
+
+			Ut::Sn::SemaphoreTypeInvokeSelector::acquire(notEmpty);
+			unregisterWaiter(nWaitingConsumers);
+		}
+	}
+
+	/// Waits for a free slot for not more than `aTimeout`. A stale
+	/// signal left from an earlier wake-up restarts the wait for the remaining
+	/// time.
+	///
+	/// \tparam TimeType `std::chrono::duration`
+	template <class TimeType>
+	bool tryPushFor(const T &aInstance, const TimeType &aTimeout)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + aTimeout;
+
+		while (!tryPush(aInstance)) {
+			if (registerWaiter(nWaitingProducers, [this, &aInstance]() {return tryPush(aInstance);})) {
+				break;
+			}
+
+			const TimeType remaining = remainingUntil<TimeType>(deadline);
+			const bool signaled = remaining > TimeType::zero()
+				&& Ut::Sn::SemaphoreTypeInvokeSelector::tryAcquireFor(notFull, remaining);
+			unregisterWaiter(nWaitingProducers);
+
+			if (!signaled) {
+				return tryPush(aInstance);
+			}
+		}
+
+		return true;
+	}
+
+	/// Waits for an element for not more than `aTimeout`. A stale
+	/// signal left from an earlier wake-up restarts the wait for the remaining
+	/// time.
+	///
+	/// \tparam TimeType `std::chrono::duration`
+	template <class TimeType>
+	bool tryPopFor(T &ret, const TimeType &aTimeout)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + aTimeout;
+
+		while (!tryPop(ret)) {
+			if (registerWaiter(nWaitingConsumers, [this, &ret]() {return tryPop(ret);})) {
+				break;
+			}
+
+			const TimeType remaining = remainingUntil<TimeType>(deadline);
+			const bool signaled = remaining > TimeType::zero()
+				&& Ut::Sn::SemaphoreTypeInvokeSelector::tryAcquireFor(notEmpty, remaining);
+			unregisterWaiter(nWaitingConsumers);
+
+			if (!signaled) {
+				return tryPop(ret);
+			}
+		}
+
+		return true;
+	}
+
+	std::size_t count() const
+	{
+		return queue.count();
+	}
+
+private:
+	/// Time left before `aDeadline`, rounded up to `TimeType`, so a coarse
+	/// unit does not cut the wait short
+	template <class TimeType, class TimePointType>
+	static TimeType remainingUntil(const TimePointType &aDeadline)
+	{
+		const auto remaining = aDeadline - std::chrono::steady_clock::now();
+		TimeType ret = std::chrono::duration_cast<TimeType>(remaining);
+
+		if (ret < remaining) {
+			ret += TimeType{1};
+		}
+
+		return ret;
+	}
+
+	/// Registers the caller as a waiter, and makes one more attempt in case
+	/// the opposite side has made progress before the registration became
+	/// visible to it.
+	///
+	/// \returns true, if the attempt has succeeded, and the caller should not
+	/// park
+	template <class CallableType>
+	static bool registerWaiter(std::atomic<std::size_t> &aNwaiting, CallableType &&aTryOperation)
+	{
+		aNwaiting.fetch_add(1, std::memory_order_seq_cst);
+		std::atomic_thread_fence(std::memory_order_seq_cst);  // Pairs with the fence in `notify`
+
+		if (aTryOperation()) {
+			unregisterWaiter(aNwaiting);
+
+			return true;
+		}
+
+		return false;
+	}
+
+	static void unregisterWaiter(std::atomic<std::size_t> &aNwaiting)
+	{
+		aNwaiting.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	static void notify(std::atomic<std::size_t> &aNwaiting, SemaphoreType &aSemaphore)
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);  // Pairs with the fence in `registerWaiter`
+
+		if (aNwaiting.load(std::memory_order_relaxed) > 0) {
+			Ut::Sn::SemaphoreTypeInvokeSelector::release(aSemaphore);
+		}
+	}
+
+private:
+	QueueType queue;
+	std::atomic<std::size_t> nWaitingConsumers{0};
+	std::atomic<std::size_t> nWaitingProducers{0};
+	SemaphoreType notEmpty;
+	SemaphoreType notFull;
+};
+
+}  // namespace Ct
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_CONTAINER_BLOCKINGFIXEDSIZEQUEUE_HPP_
@@ -0,0 +1,262 @@
+//
+// BroadcastRing.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_CONTAINER_BROADCASTRING_HPP_
+#define UTILITY_UTILITY_CONTAINER_BROADCASTRING_HPP_
+
+#include "utility/algorithm/Algorithm.hpp"
+#include "utility/container/QueueCursors.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace Ut {
+namespace Ct {
+
+/// What happens, when a reader lags behind the writer by the whole ring
+enum class BroadcastLagPolicy {
+	Block,  ///< The writer refuses new elements (`tryPush` fails) until the slowest reader catches up
+	DropOldest,  ///< The writer overwrites the oldest elements, the lagging reader skips ahead
+	Skip,  ///< The lagging reader gets detached, and the writer carries on. See `resubscribe`
+};
+
+/// Single-writer, multi-reader ring. Every element is written once, and each
+/// reader consumes it through its own cursor.
+///
+/// Each slot is guarded by a sequence number (seqlock). A reader copies the
+/// element out, and then checks that the slot has not been overwritten
+/// meanwhile. The writer only looks at reader cursors when its cached
+/// position of the slowest reader says the ring may be full.
+///
+/// `tryPush` must be called from one thread, `tryPop(aReader, ...)` - from
+/// the thread owning `aReader`. `subscribe` and `unsubscribe` may be called
+/// from any thread.
+///
+/// \tparam T must be trivially copyable, as readers may copy an element which
+/// is being overwritten, and discard the copy afterwards.
+template <class T, std::size_t N, std::size_t kMaxReaders, BroadcastLagPolicy kPolicy = BroadcastLagPolicy::Block>
+class BroadcastRing {
+	static_assert(Ut::Al::isPow2Ce(N), "Queue size must be a power of 2");
+	static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+private:
+	using MemoryChunk = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+	enum ReaderState : std::uint8_t {
+		ReaderFree,
+		ReaderAttaching,
+		ReaderActive,
+		ReaderDetached,
+	};
+
+	struct Slot {
+		std::atomic<std::size_t> sequence{0};  ///< `2 * position + 1` while being written, `2 * position + 2` when ready
+		MemoryChunk storage;
+	};
+
+	struct alignas(kCacheLineSize) Reader {
+		std::atomic<std::size_t> position{0};
+		std::atomic<std::size_t> nDropped{0};
+		std::atomic<std::uint8_t> state{ReaderFree};
+	};
+
+public:
+	static constexpr std::size_t kInvalidReader = std::numeric_limits<std::size_t>::max();
+
+	/// Registers a reader, which will receive elements pushed from now on
+	///
+	/// \returns reader identifier, or `kInvalidReader`, if there are already
+	/// `kMaxReaders` readers
+	std::size_t subscribe()
+	{
+		for (std::size_t i = 0; i < kMaxReaders; ++i) {
+			std::uint8_t expected = ReaderFree;
+
+			if (readers[i].state.compare_exchange_strong(expected, ReaderAttaching)) {
+				readers[i].nDropped.store(0, std::memory_order_relaxed);
+				attach(readers[i]);
+
+				return i;
+			}
+		}
+
+		return kInvalidReader;
+	}
+
+	void unsubscribe(std::size_t aReader)
+	{
+		readers[aReader].state.store(ReaderFree, std::memory_order_release);
+	}
+
+	/// Re-attaches a reader detached under `BroadcastLagPolicy::Skip`. The
+	/// reader continues from the newest element, and the elements it has
+	/// missed are accounted as dropped.
+	void resubscribe(std::size_t aReader)
+	{
+		Reader &reader = readers[aReader];
+		std::uint8_t expected = ReaderDetached;
+
+		if (reader.state.compare_exchange_strong(expected, ReaderAttaching)) {
+			const std::size_t position = reader.position.load(std::memory_order_relaxed);
+			reader.nDropped.fetch_add(attach(reader) - position, std::memory_order_relaxed);
+		}
+	}
+
+	bool attached(std::size_t aReader) const
+	{
+		return readers[aReader].state.load(std::memory_order_acquire) == ReaderActive;
+	}
+
+	bool tryPush(const T &aInstance)
+	{
+		const std::size_t position = pushPosition.load(std::memory_order_relaxed);
+
+		if (kPolicy != BroadcastLagPolicy::DropOldest && position - slowestPosition >= N) {
+			slowestPosition = updateSlowestPosition(position);
+
+			if (kPolicy == BroadcastLagPolicy::Block && position - slowestPosition >= N) {
+				return false;
+			}
+		}
+
+		Slot &slot = slots[absolutePosition(position)];
+		slot.sequence.store(2 * position + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		memcpy(&slot.storage, &aInstance, sizeof(T));
+		slot.sequence.store(2 * position + 2, std::memory_order_release);
+		pushPosition.store(position + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	bool tryPop(std::size_t aReader, T &ret)
+	{
+		Reader &reader = readers[aReader];
+
+		if (reader.state.load(std::memory_order_acquire) != ReaderActive) {
+			return false;
+		}
+
+		std::size_t position = reader.position.load(std::memory_order_relaxed);
+
+		while (true) {
+			Slot &slot = slots[absolutePosition(position)];
+			const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+			if (sequence < 2 * position + 2) {
+				return false;  // Not written yet
+			} else if (sequence == 2 * position + 2) {
+				memcpy(&ret, &slot.storage, sizeof(T));
+				std::atomic_thread_fence(std::memory_order_acquire);
+
+				if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+					reader.position.store(position + 1, std::memory_order_release);
+
+					return true;
+				}
+			}
+
+			// The element has been overwritten
+			if (kPolicy == BroadcastLagPolicy::Skip) {
+				reader.state.store(ReaderDetached, std::memory_order_release);
+
+				return false;
+			}
+
+			// The writer may be overwriting the oldest slot right now, so start from the one next to it
+			const std::size_t oldest = pushPosition.load(std::memory_order_acquire) - N + 1;
+			reader.nDropped.fetch_add(oldest - position, std::memory_order_relaxed);
+			position = oldest;
+			reader.position.store(position, std::memory_order_release);
+		}
+	}
+
+	/// Number of elements available for the reader. It is a snapshot, and it
+	/// may be outdated by the moment it is used.
+	std::size_t count(std::size_t aReader) const
+	{
+		const std::size_t position = readers[aReader].position.load(std::memory_order_acquire);
+		const std::size_t count = pushPosition.load(std::memory_order_acquire) - position;
+
+		return count < N ? count : N;
+	}
+
+	/// Number of elements the reader has missed due to lagging
+	std::size_t dropped(std::size_t aReader) const
+	{
+		return readers[aReader].nDropped.load(std::memory_order_relaxed);
+	}
+
+private:
+	/// Implements fast modulo `a % 2^N == a & (2^N - 1)`
+	std::size_t absolutePosition(std::size_t aAccumulatedPosition) const
+	{
+		return aAccumulatedPosition & (N - 1);
+	}
+
+	/// Publishes the reader first, and then re-reads the writer's position.
+	/// The writer may have scanned readers, and cached the slowest position
+	/// before the reader became visible to it, but not past the position
+	/// re-read here, see the fence in `updateSlowestPosition`.
+	///
+	/// \returns the position the reader starts from
+	std::size_t attach(Reader &aReader)
+	{
+		aReader.position.store(pushPosition.load(std::memory_order_acquire), std::memory_order_relaxed);
+		aReader.state.store(ReaderActive, std::memory_order_release);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const std::size_t position = pushPosition.load(std::memory_order_acquire);
+		aReader.position.store(position, std::memory_order_release);
+
+		return position;
+	}
+
+	/// Scans readers, detaches the lagging ones under `BroadcastLagPolicy::Skip`
+	///
+	/// \returns position of the slowest active reader, or `aPushPosition`, if
+	/// there are none
+	std::size_t updateSlowestPosition(std::size_t aPushPosition)
+	{
+		// Either a reader being attached is seen here, or it sees `aPushPosition`, see `attach`
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::size_t slowest = aPushPosition;
+
+		for (auto &reader : readers) {
+			if (reader.state.load(std::memory_order_acquire) != ReaderActive) {
+				continue;
+			}
+
+			const std::size_t position = reader.position.load(std::memory_order_acquire);
+
+			if (kPolicy == BroadcastLagPolicy::Skip && aPushPosition - position >= N) {
+				std::uint8_t expected = ReaderActive;
+				reader.state.compare_exchange_strong(expected, ReaderDetached);
+			} else if (aPushPosition - position > aPushPosition - slowest) {
+				slowest = position;
+			}
+		}
+
+		return slowest;
+	}
+
+private:
+	std::array<Slot, N> slots;
+	std::array<Reader, kMaxReaders> readers;
+	alignas(kCacheLineSize) std::atomic<std::size_t> pushPosition{0};
+	std::size_t slowestPosition = 0;  ///< Cached by the writer
+};
+
+template <class T, std::size_t N, std::size_t kMaxReaders, BroadcastLagPolicy kPolicy>
+constexpr std::size_t BroadcastRing<T, N, kMaxReaders, kPolicy>::kInvalidReader;
+
+}  // namespace Ct
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_CONTAINER_BROADCASTRING_HPP_
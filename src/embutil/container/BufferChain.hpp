@@ -0,0 +1,258 @@
+//
+// BufferChain.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_CONTAINER_BUFFERCHAIN_HPP_
+#define UTILITY_UTILITY_CONTAINER_BUFFERCHAIN_HPP_
+
+#include "utility/container/Buffer.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+namespace Ut {
+namespace Ct {
+
+/// Sequence of non-owning byte segments which is treated as one contiguous
+/// buffer, e.g. header + payload + CRC of an outgoing frame, so the parts do
+/// not have to be copied into a single array before transmission.
+///
+/// Empty segments are not stored. Segments are kept in a circular array, so
+/// both `prepend` and `append` are O(1), and never move the other segments.
+///
+/// \tparam kMaxSegments capacity. Both `prepend` and `append` fail, when it
+/// is exhausted.
+template <std::size_t kMaxSegments>
+class BufferChain {
+	static_assert(kMaxSegments > 0, "");
+
+public:
+	/// Forward iterator over the bytes of the chain
+	struct ByteIterator {
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::uint8_t;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const std::uint8_t *;
+		using reference = std::uint8_t;
+
+		inline friend bool operator!=(const ByteIterator &aLhs, const ByteIterator &aRhs)
+		{
+			return aLhs.segment != aRhs.segment || aLhs.offset != aRhs.offset;
+		}
+
+		inline friend bool operator==(const ByteIterator &aLhs, const ByteIterator &aRhs)
+		{
+			return !(aLhs != aRhs);
+		}
+
+		const BufferChain *owner;
+		std::size_t segment;
+		std::size_t offset;
+
+		std::uint8_t operator*() const
+		{
+			return static_cast<const std::uint8_t *>(owner->segment(segment).data())[offset];
+		}
+
+		/// Pre-increment overload
+		ByteIterator &operator++()
+		{
+			if (++offset == owner->segment(segment).size()) {
+				++segment;
+				offset = 0;
+			}
+
+			return *this;
+		}
+
+		ByteIterator operator++(int)
+		{
+			auto iterator = *this;
+			++*this;
+
+			return iterator;
+		}
+	};
+
+	BufferChain() :
+		head{0},
+		nSegments{0},
+		nBytes{0}
+	{
+	}
+
+	/// \returns false, if there is no free slot for `aSegment`
+	bool append(ConstMemoryBuffer aSegment)
+	{
+		if (aSegment.size() == 0) {
+			return true;
+		}
+
+		if (nSegments == kMaxSegments) {
+			return false;
+		}
+
+		segments[wrap(head + nSegments)] = aSegment;
+		++nSegments;
+		nBytes += aSegment.size();
+
+		return true;
+	}
+
+	/// \returns false, if there is no free slot for `aSegment`
+	bool prepend(ConstMemoryBuffer aSegment)
+	{
+		if (aSegment.size() == 0) {
+			return true;
+		}
+
+		if (nSegments == kMaxSegments) {
+			return false;
+		}
+
+		head = head == 0 ? kMaxSegments - 1 : head - 1;
+		segments[head] = aSegment;
+		++nSegments;
+		nBytes += aSegment.size();
+
+		return true;
+	}
+
+	void clear()
+	{
+		head = 0;
+		nSegments = 0;
+		nBytes = 0;
+	}
+
+	/// Total number of bytes
+	std::size_t size() const
+	{
+		return nBytes;
+	}
+
+	std::size_t segmentCount() const
+	{
+		return nSegments;
+	}
+
+	const ConstMemoryBuffer &segment(std::size_t aPosition) const
+	{
+		return segments[wrap(head + aPosition)];
+	}
+
+	ByteIterator begin() const
+	{
+		return {this, 0, 0};
+	}
+
+	ByteIterator end() const
+	{
+		return {this, nSegments, 0};
+	}
+
+	/// Constructs a chain of the bytes from a given offset
+	BufferChain asSlice(std::size_t aOffset) const
+	{
+		return asSlice(aOffset, nBytes);
+	}
+
+	/// Constructs a chain of the bytes satisfying the given range
+	/// [aOffsetBegin; aOffsetEnd). Segments on the boundaries get trimmed.
+	BufferChain asSlice(std::size_t aOffsetBegin, std::size_t aOffsetEnd) const
+	{
+		assert(aOffsetBegin <= aOffsetEnd);
+		assert(aOffsetEnd <= nBytes);
+		BufferChain ret;
+		std::size_t segmentBegin = 0;
+
+		for (std::size_t i = 0; i < nSegments && segmentBegin < aOffsetEnd; ++i) {
+			const ConstMemoryBuffer &current = segment(i);
+			const std::size_t segmentEnd = segmentBegin + current.size();
+
+			if (segmentEnd > aOffsetBegin) {
+				ret.append(current.asSlice(std::max(aOffsetBegin, segmentBegin) - segmentBegin,
+					std::min(aOffsetEnd, segmentEnd) - segmentBegin));
+			}
+
+			segmentBegin = segmentEnd;
+		}
+
+		return ret;
+	}
+
+	BufferChain &slice(std::size_t aOffset)
+	{
+		*this = asSlice(aOffset);
+
+		return *this;
+	}
+
+	BufferChain &slice(std::size_t aOffsetBegin, std::size_t aOffsetEnd)
+	{
+		*this = asSlice(aOffsetBegin, aOffsetEnd);
+
+		return *this;
+	}
+
+	/// Gathers the chain into contiguous memory. Use it as a fallback for
+	/// sinks which do not support scatter-gather output.
+	///
+	/// \returns number of bytes copied
+	std::size_t copyTo(MemoryBuffer aDestination) const
+	{
+		auto *destination = static_cast<std::uint8_t *>(aDestination.data());
+		std::size_t nCopied = 0;
+
+		for (std::size_t i = 0; i < nSegments && nCopied < aDestination.size(); ++i) {
+			const std::size_t nCopy = std::min(segment(i).size(), aDestination.size() - nCopied);
+			memcpy(destination + nCopied, segment(i).data(), nCopy);
+			nCopied += nCopy;
+		}
+
+		return nCopied;
+	}
+
+	/// Fills an array of `struct iovec` (or alike, having `iov_base` and
+	/// `iov_len` fields) for `writev` or `sendmsg`
+	///
+	/// \returns number of entries filled, which is less than `segmentCount()`,
+	/// if `aMaxCount` is not sufficient
+	template <class IovecType>
+	std::size_t fillIovec(IovecType *aIovec, std::size_t aMaxCount) const
+	{
+		const std::size_t nFill = std::min(nSegments, aMaxCount);
+
+		for (std::size_t i = 0; i < nFill; ++i) {
+			aIovec[i].iov_base = const_cast<void *>(segment(i).data());
+			aIovec[i].iov_len = segment(i).size();
+		}
+
+		return nFill;
+	}
+
+private:
+	/// \pre `aPosition < 2 * kMaxSegments`
+	static std::size_t wrap(std::size_t aPosition)
+	{
+		return aPosition < kMaxSegments ? aPosition : aPosition - kMaxSegments;
+	}
+
+private:
+	std::array<ConstMemoryBuffer, kMaxSegments> segments;
+	std::size_t head;  ///< Index of the first segment in `segments`
+	std::size_t nSegments;
+	std::size_t nBytes;
+};
+
+}  // namespace Ct
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_CONTAINER_BUFFERCHAIN_HPP_
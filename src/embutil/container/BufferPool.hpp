@@ -0,0 +1,356 @@
+//
+// BufferPool.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_CONTAINER_BUFFERPOOL_HPP_
+#define UTILITY_UTILITY_CONTAINER_BUFFERPOOL_HPP_
+
+#include "utility/container/Buffer.hpp"
+#include "utility/container/QueueCursors.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Ut {
+namespace Ct {
+
+struct BufferPoolStatistics {
+	std::size_t nExhausted;  ///< Allocation attempts failed due to the lack of free blocks
+	std::size_t nInUse;  ///< Blocks taken from the pool, including those held by `LocalCache`s
+	std::size_t peakInUse;
+};
+
+/// Pool of `kNblocks` blocks of `kBlockSize` bytes in static storage.
+///
+/// Free blocks form a lock-free stack (Treiber stack). Its head packs the
+/// index of the top block together with a tag which is incremented on every
+/// update, so a thread that has been preempted between reading the head and
+/// swapping it does not succeed, if the same block has been taken and
+/// returned meanwhile (ABA).
+///
+/// Pools of less than 65535 blocks pack the head into 32 bits (16-bit tag),
+/// so it stays lock-free on 32-bit targets. Larger pools require lock-free
+/// 64-bit atomics.
+///
+/// Blocks are handed out as move-only `Handle`s, which return the block to
+/// the pool on destruction. Threads allocating at a high rate may use a
+/// `LocalCache` to avoid contending on the stack head.
+///
+/// \pre The pool outlives every handle taken from it
+template <std::size_t kBlockSize, std::size_t kNblocks>
+class BufferPool {
+	static_assert(kBlockSize > 0 && kNblocks > 0, "");
+	static_assert(kNblocks < 0xFFFFFFFF, "Block index must fit in 32 bits");
+
+private:
+	/// Tag in the upper half, block index in the lower one
+	using HeadWord = typename std::conditional<(kNblocks < 0xFFFF), std::uint32_t, std::uint64_t>::type;
+	static_assert(sizeof(HeadWord) < 8 || ATOMIC_LLONG_LOCK_FREE == 2,
+		"64-bit atomics are not lock-free on this target, use less than 65535 blocks");
+
+	static constexpr unsigned kIndexBits = sizeof(HeadWord) * 4;
+	static constexpr std::uint32_t kNil = static_cast<std::uint32_t>((HeadWord{1} << kIndexBits) - 1);
+
+	struct alignas(alignof(std::max_align_t)) Block {
+		std::uint8_t data[kBlockSize];
+	};
+
+public:
+	/// Owns a block, and returns it to the pool on destruction
+	class Handle {
+	public:
+		Handle() :
+			pool{nullptr},
+			index{kNil}
+		{
+		}
+
+		Handle(Handle &&aOther) :
+			pool{aOther.pool},
+			index{aOther.index}
+		{
+			aOther.pool = nullptr;
+		}
+
+		Handle &operator=(Handle &&aOther)
+		{
+			if (this != &aOther) {
+				reset();
+				pool = aOther.pool;
+				index = aOther.index;
+				aOther.pool = nullptr;
+			}
+
+			return *this;
+		}
+
+		Handle(const Handle &) = delete;
+		Handle &operator=(const Handle &) = delete;
+
+		~Handle()
+		{
+			reset();
+		}
+
+		bool valid() const
+		{
+			return pool != nullptr;
+		}
+
+		explicit operator bool() const
+		{
+			return valid();
+		}
+
+		/// \pre `valid()`
+		MemoryBuffer buffer() const
+		{
+			return {pool->blocks[index].data, kBlockSize};
+		}
+
+		operator MemoryBuffer() const
+		{
+			return valid() ? buffer() : MemoryBuffer{nullptr, 0};
+		}
+
+		/// Returns the block to the pool early
+		void reset()
+		{
+			if (pool != nullptr) {
+				pool->push(index);
+				pool = nullptr;
+			}
+		}
+
+	private:
+		friend class BufferPool;
+
+		Handle(BufferPool *aPool, std::uint32_t aIndex) :
+			pool{aPool},
+			index{aIndex}
+		{
+		}
+
+		/// Gives up the ownership without returning the block
+		std::uint32_t detach()
+		{
+			pool = nullptr;
+
+			return index;
+		}
+
+	private:
+		BufferPool *pool;
+		std::uint32_t index;
+	};
+
+	/// Blocks reserved by one thread. Allocation and recycling through a cache
+	/// do not touch the shared stack, until the cache runs empty or full, and
+	/// then it exchanges `kCacheSize / 2` blocks with the pool at once.
+	///
+	/// A cache must only be used by one thread at a time. Handles allocated
+	/// from it may still be passed to and destroyed by other threads, in which
+	/// case the blocks go straight to the pool.
+	template <std::size_t kCacheSize>
+	class LocalCache {
+		static_assert(kCacheSize >= 2, "");
+
+	public:
+		explicit LocalCache(BufferPool &aPool) :
+			pool(aPool),
+			nCached{0}
+		{
+		}
+
+		~LocalCache()
+		{
+			while (nCached > 0) {
+				pool.push(cached[--nCached]);
+			}
+		}
+
+		LocalCache(const LocalCache &) = delete;
+		LocalCache &operator=(const LocalCache &) = delete;
+
+		/// \returns invalid handle, if both the cache and the pool are empty
+		Handle tryAllocate()
+		{
+			if (nCached == 0) {
+				refill();
+			}
+
+			if (nCached == 0) {
+				return pool.tryAllocate();  // Registers exhaustion
+			}
+
+			return {&pool, cached[--nCached]};
+		}
+
+		/// Takes the block back into the cache
+		void recycle(Handle &&aHandle)
+		{
+			if (aHandle.pool != &pool) {
+				aHandle.reset();
+
+				return;
+			}
+
+			if (nCached == kCacheSize) {
+				flush();
+			}
+
+			cached[nCached++] = aHandle.detach();
+		}
+
+		std::size_t count() const
+		{
+			return nCached;
+		}
+
+	private:
+		void refill()
+		{
+			while (nCached < kCacheSize / 2) {
+				const std::uint32_t index = pool.pop();
+
+				if (index == kNil) {
+					break;
+				}
+
+				cached[nCached++] = index;
+			}
+		}
+
+		void flush()
+		{
+			while (nCached > kCacheSize / 2) {
+				pool.push(cached[--nCached]);
+			}
+		}
+
+	private:
+		BufferPool &pool;
+		std::array<std::uint32_t, kCacheSize> cached;
+		std::size_t nCached;
+	};
+
+	BufferPool()
+	{
+		for (std::size_t i = 0; i < kNblocks; ++i) {
+			next[i].store(i + 1 < kNblocks ? static_cast<std::uint32_t>(i + 1) : kNil, std::memory_order_relaxed);
+		}
+
+		head.store(pack(0, 0), std::memory_order_release);
+	}
+
+	BufferPool(const BufferPool &) = delete;
+	BufferPool &operator=(const BufferPool &) = delete;
+
+	/// \returns invalid handle, if the pool is exhausted
+	Handle tryAllocate()
+	{
+		const std::uint32_t index = pop();
+
+		if (index == kNil) {
+			nExhausted.fetch_add(1, std::memory_order_relaxed);
+
+			return {};
+		}
+
+		return {this, index};
+	}
+
+	BufferPoolStatistics statistics() const
+	{
+		return {nExhausted.load(std::memory_order_relaxed), nInUse.load(std::memory_order_relaxed),
+			peakInUse.load(std::memory_order_relaxed)};
+	}
+
+	static constexpr std::size_t blockSize()
+	{
+		return kBlockSize;
+	}
+
+	static constexpr std::size_t capacity()
+	{
+		return kNblocks;
+	}
+
+private:
+	static HeadWord pack(HeadWord aTag, std::uint32_t aIndex)
+	{
+		return static_cast<HeadWord>(aTag << kIndexBits) | aIndex;
+	}
+
+	static std::uint32_t indexOf(HeadWord aHead)
+	{
+		return static_cast<std::uint32_t>(aHead & kNil);
+	}
+
+	static HeadWord nextTag(HeadWord aHead)
+	{
+		return (aHead >> kIndexBits) + 1;
+	}
+
+	std::uint32_t pop()
+	{
+		HeadWord current = head.load(std::memory_order_acquire);
+
+		while (true) {
+			const std::uint32_t index = indexOf(current);
+
+			if (index == kNil) {
+				return kNil;
+			}
+
+			// May read a stale link, if the block has been taken by another thread meanwhile. The tag check rejects it
+			const std::uint32_t nextIndex = next[index].load(std::memory_order_relaxed);
+
+			if (head.compare_exchange_weak(current, pack(nextTag(current), nextIndex), std::memory_order_acquire,
+					std::memory_order_acquire)) {
+				const std::size_t inUse = nInUse.fetch_add(1, std::memory_order_relaxed) + 1;
+				std::size_t peak = peakInUse.load(std::memory_order_relaxed);
+
+				while (inUse > peak && !peakInUse.compare_exchange_weak(peak, inUse, std::memory_order_relaxed)) {
+				}
+
+				return index;
+			}
+		}
+	}
+
+	void push(std::uint32_t aIndex)
+	{
+		nInUse.fetch_sub(1, std::memory_order_relaxed);
+		HeadWord current = head.load(std::memory_order_relaxed);
+
+		do {
+			next[aIndex].store(indexOf(current), std::memory_order_relaxed);
+		} while (!head.compare_exchange_weak(current, pack(nextTag(current), aIndex), std::memory_order_release,
+			std::memory_order_relaxed));
+	}
+
+private:
+	std::array<Block, kNblocks> blocks;
+	std::array<std::atomic<std::uint32_t>, kNblocks> next;
+	alignas(kCacheLineSize) std::atomic<HeadWord> head;
+	alignas(kCacheLineSize) std::atomic<std::size_t> nInUse{0};
+	std::atomic<std::size_t> peakInUse{0};
+	std::atomic<std::size_t> nExhausted{0};
+};
+
+template <std::size_t kBlockSize, std::size_t kNblocks>
+constexpr unsigned BufferPool<kBlockSize, kNblocks>::kIndexBits;
+
+template <std::size_t kBlockSize, std::size_t kNblocks>
+constexpr std::uint32_t BufferPool<kBlockSize, kNblocks>::kNil;
+
+}  // namespace Ct
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_CONTAINER_BUFFERPOOL_HPP_
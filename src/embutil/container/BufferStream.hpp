@@ -0,0 +1,413 @@
+//
+// BufferStream.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_CONTAINER_BUFFERSTREAM_HPP_
+#define UTILITY_UTILITY_CONTAINER_BUFFERSTREAM_HPP_
+
+#include "utility/container/Buffer.hpp"
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Ut {
+namespace Ct {
+
+enum class Endianness {
+	Little,
+	Big,
+};
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr Endianness kHostEndianness = Endianness::Big;
+#else
+constexpr Endianness kHostEndianness = Endianness::Little;
+#endif
+
+/// Serialized size of a sequence of fields, i.e. the sum of their `sizeof`s
+/// without padding
+template <class ...Ts>
+struct Layout;
+
+template <>
+struct Layout<> {
+	static constexpr std::size_t kSize = 0;
+};
+
+template <class T, class ...Ts>
+struct Layout<T, Ts...> {
+	static_assert(std::is_arithmetic<T>::value, "Only integers and floating point numbers are supported");
+	static constexpr std::size_t kSize = sizeof(T) + Layout<Ts...>::kSize;
+};
+
+namespace Impl {
+
+template <std::size_t kSize>
+struct UintOfSize;
+
+template <>
+struct UintOfSize<1> {
+	using Type = std::uint8_t;
+};
+
+template <>
+struct UintOfSize<2> {
+	using Type = std::uint16_t;
+};
+
+template <>
+struct UintOfSize<4> {
+	using Type = std::uint32_t;
+};
+
+template <>
+struct UintOfSize<8> {
+	using Type = std::uint64_t;
+};
+
+inline std::uint8_t byteSwap(std::uint8_t aValue)
+{
+	return aValue;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+
+inline std::uint16_t byteSwap(std::uint16_t aValue)
+{
+	return __builtin_bswap16(aValue);
+}
+
+inline std::uint32_t byteSwap(std::uint32_t aValue)
+{
+	return __builtin_bswap32(aValue);
+}
+
+inline std::uint64_t byteSwap(std::uint64_t aValue)
+{
+	return __builtin_bswap64(aValue);
+}
+
+#else
+
+inline std::uint16_t byteSwap(std::uint16_t aValue)
+{
+	return static_cast<std::uint16_t>((aValue >> 8) | (aValue << 8));
+}
+
+inline std::uint32_t byteSwap(std::uint32_t aValue)
+{
+	return (static_cast<std::uint32_t>(byteSwap(static_cast<std::uint16_t>(aValue))) << 16)
+		| byteSwap(static_cast<std::uint16_t>(aValue >> 16));
+}
+
+inline std::uint64_t byteSwap(std::uint64_t aValue)
+{
+	return (static_cast<std::uint64_t>(byteSwap(static_cast<std::uint32_t>(aValue))) << 32)
+		| byteSwap(static_cast<std::uint32_t>(aValue >> 32));
+}
+
+#endif
+
+/// Unaligned load, compiles into a single `mov` (+ `bswap`) on targets
+/// supporting unaligned access
+template <Endianness kEndianness, class T>
+inline T load(const std::uint8_t *aSource)
+{
+	typename UintOfSize<sizeof(T)>::Type raw;
+	memcpy(&raw, aSource, sizeof(raw));
+
+	if (kEndianness != kHostEndianness) {
+		raw = byteSwap(raw);
+	}
+
+	T ret;
+	memcpy(&ret, &raw, sizeof(ret));
+
+	return ret;
+}
+
+template <Endianness kEndianness, class T>
+inline void store(std::uint8_t *aDestination, T aValue)
+{
+	typename UintOfSize<sizeof(T)>::Type raw;
+	memcpy(&raw, &aValue, sizeof(raw));
+
+	if (kEndianness != kHostEndianness) {
+		raw = byteSwap(raw);
+	}
+
+	memcpy(aDestination, &raw, sizeof(raw));
+}
+
+}  // namespace Impl
+
+/// Cursor decoding fixed-width numbers and varints from a byte buffer.
+///
+/// Failures are sticky: once a read runs out of data, every subsequent read
+/// fails too, so a whole message may be decoded first, and `ok()` checked
+/// once at the end.
+class BufferReader {
+public:
+	explicit BufferReader(ConstMemoryBuffer aBuffer) :
+		data{static_cast<const std::uint8_t *>(aBuffer.data())},
+		size{aBuffer.size()},
+		position{0},
+		failed{false}
+	{
+	}
+
+	template <Endianness kEndianness = Endianness::Little, class T>
+	bool read(T &aValue)
+	{
+		return readFields<kEndianness>(aValue);
+	}
+
+	/// Reads consecutive fields with a single bounds check for all of them,
+	/// see `Layout`. Nothing is read, if the fields do not fit.
+	template <Endianness kEndianness = Endianness::Little, class ...Ts>
+	bool readFields(Ts &...aValues)
+	{
+		if (!require(Layout<Ts...>::kSize)) {
+			return false;
+		}
+
+		const int expand[] = {0, (aValues = Impl::load<kEndianness, Ts>(data + advance(sizeof(Ts))), 0)...};
+		(void)expand;
+
+		return true;
+	}
+
+	/// Unsigned LEB128
+	bool readVarint(std::uint64_t &aValue)
+	{
+		std::uint64_t value = 0;
+
+		for (unsigned shift = 0; shift < 64; shift += 7) {
+			if (!require(1)) {
+				return false;
+			}
+
+			const std::uint8_t byte = data[advance(1)];
+
+			if (shift == 63 && (byte & 0x7E) != 0) {
+				failed = true;  // Does not fit in 64 bits
+
+				return false;
+			}
+
+			value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+
+			if ((byte & 0x80) == 0) {
+				aValue = value;
+
+				return true;
+			}
+		}
+
+		failed = true;  // Too long
+
+		return false;
+	}
+
+	/// Zigzag-encoded LEB128
+	bool readZigzagVarint(std::int64_t &aValue)
+	{
+		std::uint64_t value = 0;
+
+		if (!readVarint(value)) {
+			return false;
+		}
+
+		aValue = static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+
+		return true;
+	}
+
+	/// \returns the next `aSize` bytes without copying, or an empty buffer
+	/// with `nullptr` data, if there are not enough of them
+	ConstMemoryBuffer view(std::size_t aSize)
+	{
+		if (!require(aSize)) {
+			return {nullptr, 0};
+		}
+
+		return {data + advance(aSize), aSize};
+	}
+
+	bool skip(std::size_t aSize)
+	{
+		return view(aSize).data() != nullptr;
+	}
+
+	std::size_t offset() const
+	{
+		return position;
+	}
+
+	std::size_t remaining() const
+	{
+		return size - position;
+	}
+
+	/// false, if any of the reads has failed
+	bool ok() const
+	{
+		return !failed;
+	}
+
+private:
+	bool require(std::size_t aSize)
+	{
+		failed = failed || aSize > size - position;
+
+		return !failed;
+	}
+
+	/// \returns position before the increment
+	std::size_t advance(std::size_t aSize)
+	{
+		position += aSize;
+
+		return position - aSize;
+	}
+
+private:
+	const std::uint8_t *data;
+	std::size_t size;
+	std::size_t position;
+	bool failed;
+};
+
+/// Cursor encoding fixed-width numbers and varints into a byte buffer. See
+/// `BufferReader`, failures are sticky the same way.
+class BufferWriter {
+public:
+	explicit BufferWriter(MemoryBuffer aBuffer) :
+		data{static_cast<std::uint8_t *>(aBuffer.data())},
+		size{aBuffer.size()},
+		position{0},
+		failed{false}
+	{
+	}
+
+	template <Endianness kEndianness = Endianness::Little, class T>
+	bool write(T aValue)
+	{
+		return writeFields<kEndianness>(aValue);
+	}
+
+	/// Writes consecutive fields with a single bounds check for all of them.
+	/// Nothing is written, if the fields do not fit.
+	template <Endianness kEndianness = Endianness::Little, class ...Ts>
+	bool writeFields(Ts ...aValues)
+	{
+		if (!require(Layout<Ts...>::kSize)) {
+			return false;
+		}
+
+		const int expand[] = {0, (Impl::store<kEndianness, Ts>(data + advance(sizeof(Ts)), aValues), 0)...};
+		(void)expand;
+
+		return true;
+	}
+
+	/// Unsigned LEB128
+	bool writeVarint(std::uint64_t aValue)
+	{
+		std::uint8_t encoded[10];
+		std::size_t nBytes = 0;
+
+		do {
+			encoded[nBytes++] = static_cast<std::uint8_t>((aValue & 0x7F) | (aValue > 0x7F ? 0x80 : 0));
+			aValue >>= 7;
+		} while (aValue > 0);
+
+		return writeBytes(toBuffer<const void>(encoded, nBytes));
+	}
+
+	/// Zigzag-encoded LEB128
+	bool writeZigzagVarint(std::int64_t aValue)
+	{
+		return writeVarint((static_cast<std::uint64_t>(aValue) << 1) ^ static_cast<std::uint64_t>(aValue >> 63));
+	}
+
+	bool writeBytes(ConstMemoryBuffer aBytes)
+	{
+		MemoryBuffer destination = reserve(aBytes.size());
+
+		if (destination.data() == nullptr) {
+			return false;
+		}
+
+		if (aBytes.size() > 0) {
+			memcpy(destination.data(), aBytes.data(), aBytes.size());
+		}
+
+		return true;
+	}
+
+	/// Skips `aSize` bytes, so the caller can fill them in place
+	///
+	/// \returns the skipped region, or an empty buffer with `nullptr` data,
+	/// if there is not enough space
+	MemoryBuffer reserve(std::size_t aSize)
+	{
+		if (!require(aSize)) {
+			return {nullptr, 0};
+		}
+
+		return {data + advance(aSize), aSize};
+	}
+
+	/// The bytes written so far
+	ConstMemoryBuffer written() const
+	{
+		return {data, position};
+	}
+
+	std::size_t offset() const
+	{
+		return position;
+	}
+
+	std::size_t remaining() const
+	{
+		return size - position;
+	}
+
+	/// false, if any of the writes has failed
+	bool ok() const
+	{
+		return !failed;
+	}
+
+private:
+	bool require(std::size_t aSize)
+	{
+		failed = failed || aSize > size - position;
+
+		return !failed;
+	}
+
+	/// \returns position before the increment
+	std::size_t advance(std::size_t aSize)
+	{
+		position += aSize;
+
+		return position - aSize;
+	}
+
+private:
+	std::uint8_t *data;
+	std::size_t size;
+	std::size_t position;
+	bool failed;
+};
+
+}  // namespace Ct
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_CONTAINER_BUFFERSTREAM_HPP_
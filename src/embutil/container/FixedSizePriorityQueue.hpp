@@ -0,0 +1,191 @@
+//
+// FixedSizePriorityQueue.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_CONTAINER_FIXEDSIZEPRIORITYQUEUE_HPP_
+#define UTILITY_UTILITY_CONTAINER_FIXEDSIZEPRIORITYQUEUE_HPP_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace Ut {
+namespace Ct {
+
+/// Priority queue over static storage. Like `std::priority_queue`, `top()` is
+/// the greatest element according to `Compare`.
+///
+/// Elements are kept in a 4-ary heap. Compared to a binary heap, it is half
+/// as deep, and the children of a node are adjacent, so a sift-down step
+/// touches one or two cache lines instead of walking across the storage.
+///
+/// Elements are constructed in place, `T` is not required to be default
+/// constructible.
+///
+/// The queue is not thread safe.
+template <class T, std::size_t N, class Compare = std::less<T>>
+class FixedSizePriorityQueue {
+	static_assert(N > 0, "");
+
+private:
+	static constexpr std::size_t kArity = 4;
+	using MemoryChunk = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+public:
+	explicit FixedSizePriorityQueue(const Compare &aCompare = Compare{}) :
+		compare{aCompare},
+		size{0}
+	{
+	}
+
+	~FixedSizePriorityQueue()
+	{
+		for (std::size_t i = 0; i < size; ++i) {
+			at(i).~T();
+		}
+	}
+
+	FixedSizePriorityQueue(const FixedSizePriorityQueue &) = delete;
+	FixedSizePriorityQueue &operator=(const FixedSizePriorityQueue &) = delete;
+
+	bool tryPush(const T &aInstance)
+	{
+		return tryEmplace(aInstance);
+	}
+
+	bool tryPush(T &&aInstance)
+	{
+		return tryEmplace(std::move(aInstance));
+	}
+
+	template <class ...Ts>
+	bool tryEmplace(Ts &&...aArgs)
+	{
+		if (size == N) {
+			return false;
+		}
+
+		new (reinterpret_cast<void *>(&storage[size])) T{std::forward<Ts>(aArgs)...};
+		++size;
+		siftUp(size - 1);
+
+		return true;
+	}
+
+	/// Moves the greatest element out
+	bool tryPop(T &ret)
+	{
+		if (size == 0) {
+			return false;
+		}
+
+		ret = std::move(at(0));
+		--size;
+
+		if (size > 0) {
+			T last{std::move(at(size))};
+			at(size).~T();
+			siftDown(std::move(last));
+		} else {
+			at(0).~T();
+		}
+
+		return true;
+	}
+
+	/// \returns the greatest element, or `nullptr`, if the queue is empty
+	const T *top() const
+	{
+		return size > 0 ? &at(0) : nullptr;
+	}
+
+	std::size_t count() const
+	{
+		return size;
+	}
+
+	constexpr std::size_t capacity() const
+	{
+		return N;
+	}
+
+private:
+	T &at(std::size_t aPosition)
+	{
+		return *reinterpret_cast<T *>(&storage[aPosition]);
+	}
+
+	const T &at(std::size_t aPosition) const
+	{
+		return *reinterpret_cast<const T *>(&storage[aPosition]);
+	}
+
+	/// Lifts the element at `aPosition` towards the root. Parents are shifted
+	/// down into the hole, so the element itself is moved only twice.
+	void siftUp(std::size_t aPosition)
+	{
+		if (aPosition == 0 || !compare(at((aPosition - 1) / kArity), at(aPosition))) {
+			return;
+		}
+
+		T instance{std::move(at(aPosition))};
+
+		do {
+			const std::size_t parent = (aPosition - 1) / kArity;
+			at(aPosition) = std::move(at(parent));
+			aPosition = parent;
+		} while (aPosition > 0 && compare(at((aPosition - 1) / kArity), instance));
+
+		at(aPosition) = std::move(instance);
+	}
+
+	/// Places `aInstance` into the hole left at the root by a removed element
+	void siftDown(T &&aInstance)
+	{
+		std::size_t position = 0;
+
+		while (true) {
+			const std::size_t firstChild = position * kArity + 1;
+
+			if (firstChild >= size) {
+				break;
+			}
+
+			const std::size_t lastChild = firstChild + kArity < size ? firstChild + kArity : size;
+			std::size_t greatest = firstChild;
+
+			for (std::size_t child = firstChild + 1; child < lastChild; ++child) {
+				if (compare(at(greatest), at(child))) {
+					greatest = child;
+				}
+			}
+
+			if (!compare(aInstance, at(greatest))) {
+				break;
+			}
+
+			at(position) = std::move(at(greatest));
+			position = greatest;
+		}
+
+		at(position) = std::move(aInstance);
+	}
+
+private:
+	std::array<MemoryChunk, N> storage;
+	Compare compare;
+	std::size_t size;
+};
+
+template <class T, std::size_t N, class Compare>
+constexpr std::size_t FixedSizePriorityQueue<T, N, Compare>::kArity;
+
+}  // namespace Ct
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_CONTAINER_FIXEDSIZEPRIORITYQUEUE_HPP_
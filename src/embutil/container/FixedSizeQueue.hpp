@@ -9,143 +9,54 @@
 #define UTILITY_UTILITY_CONTAINER_FIXEDSIZEQUEUE_HPP_
 
 #include "utility/algorithm/Algorithm.hpp"
+#include "utility/container/QueueCursors.hpp"
+#include "utility/container/QueueStatistics.hpp"
+#include "utility/container/RingQueue.hpp"
 #include <array>
 #include <cstdint>
 
 namespace Ut {
 namespace Ct {
+namespace Impl {
 
-/// Fixed-size queue for buffers and alike.
-///
-/// The queue is thread safe for as long as there are only 2 threads operating
-/// on it: one reads, and the other one - pushes
 template <class T, std::size_t N>
-class FixedSizeQueue {
-	static_assert(Ut::Al::isPow2Ce(N), "Queue size must be a power of 2");
-
-private:
-	using MemoryChunk = std::uint8_t[sizeof(T)];
-
-public:
-	template <class OwnerType, class ItemType>
-	struct Iterator {
-
-		inline friend bool operator!=(const Iterator &aLhs, const Iterator &aRhs)
-		{
-			return aLhs.position != aRhs.position;
-		}
-
-		OwnerType &owner;
-		std::size_t position;
-
-		ItemType &operator*()
-		{
-			return *reinterpret_cast<ItemType *>(owner.storage[owner.absolutePosition(position)]);
-		}
-
-		/// Pre-increment overload
-		Iterator &operator++()
-		{
-			++position;
-			return *this;
-		}
-
-		Iterator operator++(int)
-		{
-			auto iterator = *this;
-			++position;
-
-			return iterator;
-		}
-	};
-
-	Iterator<FixedSizeQueue<T, N>, T> begin()
-	{
-		return {*this, popPosition};
-	}
-
-	Iterator<FixedSizeQueue<T, N>, T> end()
-	{
-		return {*this, pushPosition};
-	}
-
-	Iterator<const FixedSizeQueue<T, N>, const T> cbegin() const
-	{
-		return {*this, popPosition};
-	}
-
-	Iterator<const FixedSizeQueue<T, N>, const T> cend() const
-	{
-		return {*this, pushPosition};
-	}
-
-	void forcePush(const T &aInstance)
-	{
-		if (!tryPush(aInstance)) {
-			T t;
-			tryPop(t);
-			tryPush(aInstance);
-		}
-	}
-
-	bool tryPush(const T &aInstance)
+struct FixedRingStorage {
+	RingQueueChunk<T> *chunks()
 	{
-		if (count() < N) {
-			new (reinterpret_cast<void *>(storage[absolutePosition(pushPosition)])) T{aInstance};
-			++pushPosition;
-
-			return true;
-		} else {
-			return false;
-		}
+		return storage.data();
 	}
 
-	template <class ...Ts>
-	bool tryEmplace(Ts &&...aArgs)
+	const RingQueueChunk<T> *chunks() const
 	{
-		if (count() < N) {
-			new (reinterpret_cast<void *>(storage[absolutePosition(pushPosition)])) T{std::forward<Ts>(aArgs)...};
-			++pushPosition;
-
-			return true;
-		} else {
-			return false;
-		}
+		return storage.data();
 	}
 
-	bool tryPop(T &ret)
+	constexpr std::size_t capacity() const
 	{
-		if (count()) {
-			T *element = reinterpret_cast<T *>(storage[absolutePosition(popPosition)]);
-			ret = std::move(*element);
-			element->~T();
-			++popPosition;
-
-			return true;
-		}
-
-		return false;
+		return N;
 	}
 
-	/// Number of elements stored in the queue
-	std::size_t count() const
-	{
-		return pushPosition - popPosition;
-	}
+	std::array<RingQueueChunk<T>, N> storage;
+};
 
-private:
-	/// Implements fast modulo `a % 2^N == a & (2^N - 1)`
-	std::size_t absolutePosition(std::size_t aAccumulatedPosition) const
-	{
-		return aAccumulatedPosition & (N - 1);
-	}
+}  // namespace Impl
 
-private:
-	std::array<MemoryChunk, N> storage;
-	std::size_t popPosition = 0;
-	std::size_t pushPosition = 0;
+/// Fixed-size queue for buffers and alike.
+///
+/// \tparam CursorsType defines how read and write positions are synchronized,
+/// see `RingQueue`. The queue is not thread safe by default.
+/// \tparam StatisticsType optional instrumentation, see `QueueStatistics`
+template <class T, std::size_t N, class CursorsType = PlainQueueCursors, class StatisticsType = NoQueueStatistics>
+class FixedSizeQueue : public RingQueue<T, Impl::FixedRingStorage<T, N>, CursorsType, StatisticsType> {
+	static_assert(Ut::Al::isPow2Ce(N), "Queue size must be a power of 2");
+	static_assert(StatisticsType::kNtimestampSlots == 0 || StatisticsType::kNtimestampSlots >= N,
+		"There must be a timestamp slot for every element");
 };
 
+/// Lock-free single producer single consumer queue
+template <class T, std::size_t N, class StatisticsType = NoQueueStatistics>
+using SpscFixedSizeQueue = FixedSizeQueue<T, N, SpscQueueCursors, StatisticsType>;
+
 }  // namespace Ct
 }  // namespace Ut
 
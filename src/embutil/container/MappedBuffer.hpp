@@ -0,0 +1,273 @@
+//
+// MappedBuffer.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_CONTAINER_MAPPEDBUFFER_HPP_
+#define UTILITY_UTILITY_CONTAINER_MAPPEDBUFFER_HPP_
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include "utility/container/Buffer.hpp"
+#include <cstdint>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace Ut {
+namespace Ct {
+
+enum class MappedBufferAccess {
+	ReadOnly,
+	ReadWrite,  ///< Changes are written back to the file
+};
+
+/// `madvise` hints
+enum class MappedBufferAdvice {
+	Normal,
+	Sequential,  ///< Aggressive read-ahead, pages behind may be dropped early
+	Random,  ///< No read-ahead
+	WillNeed,  ///< Start reading the window in now
+	DontNeed,
+	HugePage,  ///< Transparent huge pages, Linux only. Only takes effect for file systems supporting them
+};
+
+/// File mapped into memory, and exposed as a `Ut::Ct::Buffer`, so it can be
+/// handed to parsers without loading it first. Pages are read in on first
+/// access.
+///
+/// Files larger than the address space budget may be mapped through a
+/// window of a fixed size, which is moved over the file with `mapWindow`.
+///
+/// POSIX only. Check `valid()` to find out whether the mapping has
+/// succeeded. A failed `mapWindow` makes it false, until a later one
+/// succeeds.
+class MappedBuffer {
+public:
+	/// \arg aWindowSize maximum size of the mapped region, 0 maps the whole
+	/// file. The window is mapped at the beginning of the file.
+	explicit MappedBuffer(const char *aPath, MappedBufferAccess aAccess = MappedBufferAccess::ReadOnly,
+		std::size_t aWindowSize = 0) :
+		fd{-1},
+		access{aAccess},
+		nFileBytes{0},
+		windowSize{aWindowSize},
+		mapping{nullptr},
+		nMappingBytes{0},
+		offset{0},
+		nBytes{0},
+		isWindowMapped{false}
+	{
+		fd = open(aPath, aAccess == MappedBufferAccess::ReadOnly ? O_RDONLY : O_RDWR);
+
+		if (fd < 0) {
+			return;
+		}
+
+		struct stat fileStatus;
+
+		if (fstat(fd, &fileStatus) != 0) {
+			close(fd);
+			fd = -1;
+
+			return;
+		}
+
+		nFileBytes = static_cast<std::size_t>(fileStatus.st_size);
+
+		if (!mapWindow(0)) {
+			close(fd);
+			fd = -1;
+		}
+	}
+
+	~MappedBuffer()
+	{
+		unmap();
+
+		if (fd >= 0) {
+			close(fd);
+		}
+	}
+
+	MappedBuffer(MappedBuffer &&aOther) :
+		fd{aOther.fd},
+		access{aOther.access},
+		nFileBytes{aOther.nFileBytes},
+		windowSize{aOther.windowSize},
+		mapping{aOther.mapping},
+		nMappingBytes{aOther.nMappingBytes},
+		offset{aOther.offset},
+		nBytes{aOther.nBytes},
+		isWindowMapped{aOther.isWindowMapped}
+	{
+		aOther.fd = -1;
+		aOther.mapping = nullptr;
+		aOther.nMappingBytes = 0;
+		aOther.nBytes = 0;
+		aOther.isWindowMapped = false;
+	}
+
+	MappedBuffer(const MappedBuffer &) = delete;
+	MappedBuffer &operator=(const MappedBuffer &) = delete;
+	MappedBuffer &operator=(MappedBuffer &&) = delete;
+
+	/// The file is open, and the window is mapped
+	bool valid() const
+	{
+		return fd >= 0 && isWindowMapped;
+	}
+
+	/// The mapped window
+	ConstMemoryBuffer buffer() const
+	{
+		return {data(), nBytes};
+	}
+
+	/// The mapped window, or an empty buffer with `nullptr` data, if the file
+	/// is mapped read-only
+	MemoryBuffer mutableBuffer()
+	{
+		return access == MappedBufferAccess::ReadWrite ? MemoryBuffer{data(), nBytes} : MemoryBuffer{nullptr, 0};
+	}
+
+	/// Moves the window, so it starts at `aOffset` bytes into the file. The
+	/// window gets clipped at the end of the file.
+	///
+	/// \returns false, if `aOffset` is past the end of the file, or if the
+	/// mapping has failed. In the latter case, nothing is mapped.
+	bool mapWindow(std::size_t aOffset)
+	{
+		if (aOffset > nFileBytes) {
+			return false;
+		}
+
+		unmap();
+		const std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+		const std::size_t mappingOffset = aOffset - aOffset % pageSize;
+		const std::size_t nAvailable = nFileBytes - aOffset;
+		nBytes = windowSize == 0 || windowSize > nAvailable ? nAvailable : windowSize;
+		offset = aOffset;
+		isWindowMapped = nBytes == 0;
+
+		if (nBytes == 0) {
+			return true;
+		}
+
+		nMappingBytes = nBytes + (aOffset - mappingOffset);
+		void *address = mmap(nullptr, nMappingBytes,
+			access == MappedBufferAccess::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+			static_cast<off_t>(mappingOffset));
+
+		if (address == MAP_FAILED) {
+			nBytes = 0;
+
+			return false;
+		}
+
+		mapping = static_cast<std::uint8_t *>(address);
+		isWindowMapped = true;
+
+		return true;
+	}
+
+	/// Applies `madvise` to the mapped window
+	bool advise(MappedBufferAdvice aAdvice)
+	{
+		if (mapping == nullptr) {
+			return false;
+		}
+
+		int advice = MADV_NORMAL;
+
+		switch (aAdvice) {
+			case MappedBufferAdvice::Sequential:
+				advice = MADV_SEQUENTIAL;
+
+				break;
+
+			case MappedBufferAdvice::Random:
+				advice = MADV_RANDOM;
+
+				break;
+
+			case MappedBufferAdvice::WillNeed:
+				advice = MADV_WILLNEED;
+
+				break;
+
+			case MappedBufferAdvice::DontNeed:
+				advice = MADV_DONTNEED;
+
+				break;
+
+			case MappedBufferAdvice::HugePage:
+#if defined(MADV_HUGEPAGE)
+				advice = MADV_HUGEPAGE;
+
+				break;
+#else
+				return false;
+#endif
+
+			default:
+				break;
+		}
+
+		return madvise(mapping, nMappingBytes, advice) == 0;
+	}
+
+	/// Flushes changes made through `mutableBuffer` to the file
+	bool sync()
+	{
+		return mapping == nullptr || msync(mapping, nMappingBytes, MS_SYNC) == 0;
+	}
+
+	std::size_t fileSize() const
+	{
+		return nFileBytes;
+	}
+
+	/// Offset of the window in the file
+	std::size_t windowOffset() const
+	{
+		return offset;
+	}
+
+private:
+	std::uint8_t *data() const
+	{
+		return mapping == nullptr ? nullptr : mapping + (nMappingBytes - nBytes);
+	}
+
+	void unmap()
+	{
+		if (mapping != nullptr) {
+			munmap(mapping, nMappingBytes);
+			mapping = nullptr;
+			nMappingBytes = 0;
+		}
+	}
+
+private:
+	int fd;
+	MappedBufferAccess access;
+	std::size_t nFileBytes;
+	std::size_t windowSize;
+	std::uint8_t *mapping;  ///< Page-aligned, may start before the window
+	std::size_t nMappingBytes;
+	std::size_t offset;
+	std::size_t nBytes;
+	bool isWindowMapped;  ///< The last `mapWindow` has succeeded
+};
+
+}  // namespace Ct
+}  // namespace Ut
+
+#endif  // defined(__unix__) || defined(__APPLE__)
+
+#endif // UTILITY_UTILITY_CONTAINER_MAPPEDBUFFER_HPP_
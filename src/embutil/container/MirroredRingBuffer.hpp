@@ -0,0 +1,199 @@
+//
+// MirroredRingBuffer.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_CONTAINER_MIRROREDRINGBUFFER_HPP_
+#define UTILITY_UTILITY_CONTAINER_MIRROREDRINGBUFFER_HPP_
+
+#if defined(__linux__)
+
+#include "utility/algorithm/Algorithm.hpp"
+#include "utility/container/Buffer.hpp"
+#include "utility/container/QueueCursors.hpp"
+#include <cstdint>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace Ut {
+namespace Ct {
+
+/// Byte ring buffer which maps the same memory pages twice, back to back.
+///
+/// Any readable or writable region, including the ones crossing the end of
+/// the ring, is therefore contiguous in the address space, and can be handed
+/// to parsers, or to `read()` / `write()` as a single `Ut::Ct::Buffer`
+/// without copying wrapped data into a scratch buffer.
+///
+/// Linux only, uses `memfd_create`.
+///
+/// \tparam CursorsType defines how read and write positions are synchronized,
+/// see `RingQueue`. By default, the buffer is lock-free and thread safe for
+/// one producer and one consumer.
+template <class CursorsType = SpscQueueCursors>
+class MirroredRingBuffer {
+public:
+	/// \arg aSize is rounded up to a power of 2 number of memory pages.
+	/// Check `valid()` to find out whether the mapping has succeeded.
+	explicit MirroredRingBuffer(std::size_t aSize) :
+		base{nullptr},
+		nBytes{roundUpCapacity(aSize)},
+		cursors{}
+	{
+		map();
+	}
+
+	~MirroredRingBuffer()
+	{
+		if (base != nullptr) {
+			munmap(base, 2 * nBytes);
+		}
+	}
+
+	MirroredRingBuffer(const MirroredRingBuffer &) = delete;
+	MirroredRingBuffer &operator=(const MirroredRingBuffer &) = delete;
+
+	bool valid() const
+	{
+		return base != nullptr;
+	}
+
+	/// Free region for the producer to fill in place. Publish the written
+	/// bytes with `commit`. Empty with `nullptr` data, if not `valid()`
+	MemoryBuffer writable()
+	{
+		if (!valid()) {
+			return {nullptr, 0};
+		}
+
+		const std::size_t size = cursors.writable(nBytes, nBytes);
+
+		return {base + absolutePosition(cursors.pushCursor()), size};
+	}
+
+	void commit(std::size_t aSize)
+	{
+		cursors.publishPush(cursors.pushCursor() + aSize);
+	}
+
+	/// Region available to the consumer. Free the consumed bytes with
+	/// `release`. Empty with `nullptr` data, if not `valid()`
+	ConstMemoryBuffer readable()
+	{
+		if (!valid()) {
+			return {nullptr, 0};
+		}
+
+		const std::size_t size = cursors.readable(nBytes);
+
+		return {base + absolutePosition(cursors.popCursor()), size};
+	}
+
+	void release(std::size_t aSize)
+	{
+		cursors.publishPop(cursors.popCursor() + aSize);
+	}
+
+	/// Reads from a file descriptor straight into the free region
+	///
+	/// \returns the result of `read()`
+	ssize_t readFrom(int aFileDescriptor)
+	{
+		MemoryBuffer region = writable();
+		const ssize_t ret = ::read(aFileDescriptor, region.data(), region.size());
+
+		if (ret > 0) {
+			commit(static_cast<std::size_t>(ret));
+		}
+
+		return ret;
+	}
+
+	/// Writes the readable region straight into a file descriptor
+	///
+	/// \returns the result of `write()`
+	ssize_t writeTo(int aFileDescriptor)
+	{
+		ConstMemoryBuffer region = readable();
+		const ssize_t ret = ::write(aFileDescriptor, region.data(), region.size());
+
+		if (ret > 0) {
+			release(static_cast<std::size_t>(ret));
+		}
+
+		return ret;
+	}
+
+	std::size_t capacity() const
+	{
+		return nBytes;
+	}
+
+	std::size_t count() const
+	{
+		return cursors.count();
+	}
+
+private:
+	static std::size_t roundUpCapacity(std::size_t aSize)
+	{
+		const auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+		const std::size_t nPages = aSize > pageSize ? (aSize + pageSize - 1) / pageSize : 1;
+		const std::size_t nPagesPow2 = Ut::Al::floorPow2(nPages);
+
+		return (nPagesPow2 == nPages ? nPages : 2 * nPagesPow2) * pageSize;
+	}
+
+	/// Reserves an address range of twice the capacity, and maps the same
+	/// memory file over both halves of it
+	void map()
+	{
+		const int fd = memfd_create("Ut::Ct::MirroredRingBuffer", MFD_CLOEXEC);
+
+		if (fd < 0) {
+			return;
+		}
+
+		void *reserved = MAP_FAILED;
+
+		if (ftruncate(fd, static_cast<off_t>(nBytes)) == 0) {
+			reserved = mmap(nullptr, 2 * nBytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		}
+
+		if (reserved != MAP_FAILED) {
+			auto *lower = reinterpret_cast<std::uint8_t *>(reserved);
+			const bool mapped =
+				mmap(lower, nBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED
+				&& mmap(lower + nBytes, nBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+
+			if (mapped) {
+				base = lower;
+			} else {
+				munmap(reserved, 2 * nBytes);
+			}
+		}
+
+		close(fd);  // The mappings keep the memory alive
+	}
+
+	/// Implements fast modulo `a % 2^N == a & (2^N - 1)`
+	std::size_t absolutePosition(std::size_t aAccumulatedPosition) const
+	{
+		return aAccumulatedPosition & (nBytes - 1);
+	}
+
+private:
+	std::uint8_t *base;
+	std::size_t nBytes;
+	CursorsType cursors;
+};
+
+}  // namespace Ct
+}  // namespace Ut
+
+#endif  // defined(__linux__)
+
+#endif // UTILITY_UTILITY_CONTAINER_MIRROREDRINGBUFFER_HPP_
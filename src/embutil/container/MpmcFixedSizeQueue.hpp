@@ -0,0 +1,156 @@
+//
+// MpmcFixedSizeQueue.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_CONTAINER_MPMCFIXEDSIZEQUEUE_HPP_
+#define UTILITY_UTILITY_CONTAINER_MPMCFIXEDSIZEQUEUE_HPP_
+
+#include "utility/algorithm/Algorithm.hpp"
+#include "utility/container/QueueCursors.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace Ut {
+namespace Ct {
+
+/// Lock-free bounded multi-producer multi-consumer queue.
+///
+/// Each cell has a sequence number which tells, whether the cell is ready for
+/// being written into, or read from, at a given accumulated position. A
+/// producer (consumer) claims a position with CAS on the push (pop) cursor,
+/// and then publishes the cell by updating its sequence number. Therefore,
+/// neither pushes nor pops take any locks, and threads only contend on the
+/// cursor of their side.
+///
+/// Based on D. Vyukov's bounded MPMC queue.
+template <class T, std::size_t N>
+class MpmcFixedSizeQueue {
+	static_assert(Ut::Al::isPow2Ce(N), "Queue size must be a power of 2");
+
+private:
+	using MemoryChunk = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+	struct Cell {
+		std::atomic<std::size_t> sequence;
+		MemoryChunk storage;
+	};
+
+public:
+	MpmcFixedSizeQueue()
+	{
+		for (std::size_t i = 0; i < N; ++i) {
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	~MpmcFixedSizeQueue()
+	{
+		const std::size_t push = pushPosition.value.load(std::memory_order_acquire);
+
+		for (std::size_t position = popPosition.value.load(std::memory_order_acquire); position != push; ++position) {
+			reinterpret_cast<T *>(&cells[absolutePosition(position)].storage)->~T();
+		}
+	}
+
+	MpmcFixedSizeQueue(const MpmcFixedSizeQueue &) = delete;
+	MpmcFixedSizeQueue &operator=(const MpmcFixedSizeQueue &) = delete;
+
+	bool tryPush(const T &aInstance)
+	{
+		return tryEmplace(aInstance);
+	}
+
+	template <class ...Ts>
+	bool tryEmplace(Ts &&...aArgs)
+	{
+		std::size_t position = pushPosition.value.load(std::memory_order_relaxed);
+		Cell *cell = nullptr;
+
+		while (true) {
+			cell = &cells[absolutePosition(position)];
+			const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+			if (difference == 0) {
+				if (pushPosition.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (difference < 0) {
+				return false;  // The cell has not been released by a consumer yet, the queue is full
+			} else {
+				position = pushPosition.value.load(std::memory_order_relaxed);
+			}
+		}
+
+		new (reinterpret_cast<void *>(&cell->storage)) T{std::forward<Ts>(aArgs)...};
+		cell->sequence.store(position + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	bool tryPop(T &ret)
+	{
+		std::size_t position = popPosition.value.load(std::memory_order_relaxed);
+		Cell *cell = nullptr;
+
+		while (true) {
+			cell = &cells[absolutePosition(position)];
+			const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+
+			if (difference == 0) {
+				if (popPosition.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (difference < 0) {
+				return false;  // The cell has not been published by a producer yet, the queue is empty
+			} else {
+				position = popPosition.value.load(std::memory_order_relaxed);
+			}
+		}
+
+		T *element = reinterpret_cast<T *>(&cell->storage);
+		ret = std::move(*element);
+		element->~T();
+		cell->sequence.store(position + N, std::memory_order_release);
+
+		return true;
+	}
+
+	/// Number of elements stored in the queue. It is a snapshot, and it may be
+	/// outdated by the moment it is used.
+	std::size_t count() const
+	{
+		const std::size_t pop = popPosition.value.load(std::memory_order_acquire);
+		const std::size_t push = pushPosition.value.load(std::memory_order_acquire);
+
+		return push > pop ? push - pop : 0;
+	}
+
+private:
+	/// Implements fast modulo `a % 2^N == a & (2^N - 1)`
+	std::size_t absolutePosition(std::size_t aAccumulatedPosition) const
+	{
+		return aAccumulatedPosition & (N - 1);
+	}
+
+private:
+	struct alignas(kCacheLineSize) Cursor {
+		std::atomic<std::size_t> value{0};
+	};
+
+	std::array<Cell, N> cells;
+	Cursor pushPosition;
+	Cursor popPosition;
+};
+
+}  // namespace Ct
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_CONTAINER_MPMCFIXEDSIZEQUEUE_HPP_
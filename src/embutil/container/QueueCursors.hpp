@@ -0,0 +1,151 @@
+//
+// QueueCursors.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_CONTAINER_QUEUECURSORS_HPP_
+#define UTILITY_UTILITY_CONTAINER_QUEUECURSORS_HPP_
+
+#include <atomic>
+#include <cstdint>
+
+namespace Ut {
+namespace Ct {
+
+/// Used for padding entities that are written from different threads, so
+/// they do not share a cache line
+constexpr std::size_t kCacheLineSize = 64;
+
+/// Read and write positions of a ring queue that is either used from one
+/// thread, or synchronized externally (e.g. with `Ut::Sn::LockWrapper`).
+///
+/// Positions are accumulated, i.e. they are only ever incremented, and
+/// translated into storage indices by the queue itself.
+class PlainQueueCursors {
+public:
+	std::size_t pushCursor() const
+	{
+		return pushPosition;
+	}
+
+	std::size_t popCursor() const
+	{
+		return popPosition;
+	}
+
+	/// Number of elements available for reading
+	std::size_t readable(std::size_t aRequired)
+	{
+		(void)aRequired;
+
+		return pushPosition - popPosition;
+	}
+
+	/// Number of free slots available for writing
+	std::size_t writable(std::size_t aCapacity, std::size_t aRequired)
+	{
+		(void)aRequired;
+
+		return aCapacity - (pushPosition - popPosition);
+	}
+
+	void publishPush(std::size_t aPushPosition)
+	{
+		pushPosition = aPushPosition;
+	}
+
+	void publishPop(std::size_t aPopPosition)
+	{
+		popPosition = aPopPosition;
+	}
+
+	std::size_t count() const
+	{
+		return pushPosition - popPosition;
+	}
+
+private:
+	std::size_t popPosition = 0;
+	std::size_t pushPosition = 0;
+};
+
+/// Lock-free single producer single consumer cursors.
+///
+/// Each position is only written by its owner thread and published with
+/// release semantics, so the other side never observes a slot before it is
+/// fully written (or fully read). The positions reside on separate cache
+/// lines, and each side keeps a cached copy of the other side's position,
+/// which is only refreshed when the cached value is not sufficient.
+///
+/// `pushCursor`, `writable`, `publishPush` may only be called by the producer,
+/// `popCursor`, `readable`, `publishPop` - by the consumer.
+class SpscQueueCursors {
+public:
+	std::size_t pushCursor() const
+	{
+		return producer.position.load(std::memory_order_relaxed);
+	}
+
+	std::size_t popCursor() const
+	{
+		return consumer.position.load(std::memory_order_relaxed);
+	}
+
+	std::size_t readable(std::size_t aRequired)
+	{
+		const std::size_t popPosition = consumer.position.load(std::memory_order_relaxed);
+
+		if (consumer.otherPosition - popPosition < aRequired) {
+			consumer.otherPosition = producer.position.load(std::memory_order_acquire);
+		}
+
+		return consumer.otherPosition - popPosition;
+	}
+
+	std::size_t writable(std::size_t aCapacity, std::size_t aRequired)
+	{
+		const std::size_t pushPosition = producer.position.load(std::memory_order_relaxed);
+
+		if (aCapacity - (pushPosition - producer.otherPosition) < aRequired) {
+			producer.otherPosition = consumer.position.load(std::memory_order_acquire);
+		}
+
+		return aCapacity - (pushPosition - producer.otherPosition);
+	}
+
+	void publishPush(std::size_t aPushPosition)
+	{
+		producer.position.store(aPushPosition, std::memory_order_release);
+	}
+
+	void publishPop(std::size_t aPopPosition)
+	{
+		consumer.position.store(aPopPosition, std::memory_order_release);
+	}
+
+	/// May be called from any thread. The result is a snapshot, and it may
+	/// be outdated by the moment it is used.
+	std::size_t count() const
+	{
+		// Pop position is loaded first, so the result never underflows
+		const std::size_t popPosition = consumer.position.load(std::memory_order_acquire);
+
+		return producer.position.load(std::memory_order_acquire) - popPosition;
+	}
+
+private:
+	struct alignas(kCacheLineSize) Side {
+		std::atomic<std::size_t> position{0};
+		std::size_t otherPosition = 0;  ///< Cached position of the opposite side
+	};
+
+	Side producer;
+	Side consumer;
+};
+
+}  // namespace Ct
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_CONTAINER_QUEUECURSORS_HPP_
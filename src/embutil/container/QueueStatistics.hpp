@@ -0,0 +1,167 @@
+//
+// QueueStatistics.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_CONTAINER_QUEUESTATISTICS_HPP_
+#define UTILITY_UTILITY_CONTAINER_QUEUESTATISTICS_HPP_
+
+#include "utility/algorithm/Algorithm.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Ut {
+namespace Ct {
+
+/// Default statistics policy of `RingQueue`. The queue skips every hook at
+/// compile time, when `kEnabled` is false.
+struct NoQueueStatistics {
+	static constexpr bool kEnabled = false;
+	static constexpr std::size_t kNtimestampSlots = 0;  ///< See `QueueStatistics`
+
+	void onPush(std::size_t, std::size_t, std::size_t)
+	{
+	}
+
+	void onPushFailed(std::size_t)
+	{
+	}
+
+	void onForcedDrop()
+	{
+	}
+
+	void onPop(std::size_t, std::size_t)
+	{
+	}
+};
+
+template <std::size_t kNbins>
+struct QueueStatisticsSnapshot {
+	std::size_t peakCount;  ///< The largest `count()` observed
+	std::size_t nForcedDrops;  ///< Elements dropped by `forcePush`
+	std::size_t nFailedPushes;  ///< Elements rejected by `tryPush`, `tryEmplace`, `tryReserve`, or `tryPushN`
+
+	/// Residency time histogram, if enabled. Bin `i > 0` counts elements which
+	/// stayed in the queue for [2^(i-1), 2^i) microseconds, bin 0 - for less
+	/// than 1 microsecond. The last bin also counts everything above its range.
+	std::array<std::size_t, kNbins> residency;
+};
+
+/// Statistics policy of `RingQueue` which tracks the peak `count()`, forced
+/// drops, failed pushes, and, optionally, the histogram of time elements
+/// spend in the queue.
+///
+/// Every counter has a single writer: the producer, or the consumer, so they
+/// are updated without RMW operations. `snapshot()` may be called from any
+/// thread without stopping either of them.
+///
+/// \tparam kTimestampSlots enables residency time tracking, when non-zero.
+/// Must be a power of 2 not less than the queue's capacity, e.g. `N` for
+/// `FixedSizeQueue<T, N>`, or the producer would overwrite timestamps the
+/// consumer is reading. `FixedSizeQueue` checks it at compile time,
+/// `RingBuffer` - with an assertion.
+template <std::size_t kTimestampSlots = 0, class ClockType = std::chrono::steady_clock, std::size_t kNbins = 24>
+class QueueStatistics {
+	static_assert(kTimestampSlots == 0 || Ut::Al::isPow2Ce(kTimestampSlots), "Must be a power of 2");
+	static_assert(kNbins > 0, "");
+
+public:
+	static constexpr bool kEnabled = true;
+	static constexpr std::size_t kNtimestampSlots = kTimestampSlots;
+	using Snapshot = QueueStatisticsSnapshot<kNbins>;
+
+	/// Called by the producer before elements `[aPositionBegin; aPositionEnd)`
+	/// get published
+	void onPush(std::size_t aPositionBegin, std::size_t aPositionEnd, std::size_t aCount)
+	{
+		if (aCount > peakCount.load(std::memory_order_relaxed)) {
+			peakCount.store(aCount, std::memory_order_relaxed);
+		}
+
+		if (kTimestampSlots > 0) {
+			const auto now = ClockType::now();
+
+			for (std::size_t position = aPositionBegin; position != aPositionEnd; ++position) {
+				pushTime[position & kTimestampMask] = now;
+			}
+		}
+	}
+
+	void onPushFailed(std::size_t aNelements)
+	{
+		increment(nFailedPushes, aNelements);
+	}
+
+	void onForcedDrop()
+	{
+		increment(nForcedDrops, 1);
+	}
+
+	/// Called by the consumer before elements `[aPositionBegin; aPositionEnd)`
+	/// get released
+	void onPop(std::size_t aPositionBegin, std::size_t aPositionEnd)
+	{
+		if (kTimestampSlots > 0) {
+			const auto now = ClockType::now();
+
+			for (std::size_t position = aPositionBegin; position != aPositionEnd; ++position) {
+				const auto residency = std::chrono::duration_cast<std::chrono::microseconds>(now
+					- pushTime[position & kTimestampMask]).count();
+				increment(residencyHistogram[binOf(static_cast<std::uint64_t>(residency > 0 ? residency : 0))], 1);
+			}
+		}
+	}
+
+	Snapshot snapshot() const
+	{
+		Snapshot ret;
+		ret.peakCount = peakCount.load(std::memory_order_relaxed);
+		ret.nForcedDrops = nForcedDrops.load(std::memory_order_relaxed);
+		ret.nFailedPushes = nFailedPushes.load(std::memory_order_relaxed);
+
+		for (std::size_t i = 0; i < kNbins; ++i) {
+			ret.residency[i] = residencyHistogram[i].load(std::memory_order_relaxed);
+		}
+
+		return ret;
+	}
+
+private:
+	static constexpr std::size_t kTimestampMask = kTimestampSlots > 0 ? kTimestampSlots - 1 : 0;
+
+	/// Single-writer increment
+	static void increment(std::atomic<std::size_t> &aCounter, std::size_t aValue)
+	{
+		aCounter.store(aCounter.load(std::memory_order_relaxed) + aValue, std::memory_order_relaxed);
+	}
+
+	/// Bit length of `aMicroseconds`, clamped to the last bin
+	static std::size_t binOf(std::uint64_t aMicroseconds)
+	{
+		std::size_t bin = 0;
+
+		while (aMicroseconds > 0 && bin < kNbins - 1) {
+			aMicroseconds >>= 1;
+			++bin;
+		}
+
+		return bin;
+	}
+
+private:
+	std::atomic<std::size_t> peakCount{0};
+	std::atomic<std::size_t> nForcedDrops{0};
+	std::atomic<std::size_t> nFailedPushes{0};
+	std::array<std::atomic<std::size_t>, kNbins> residencyHistogram{};
+	std::array<typename ClockType::time_point, kTimestampSlots> pushTime{};
+};
+
+}  // namespace Ct
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_CONTAINER_QUEUESTATISTICS_HPP_
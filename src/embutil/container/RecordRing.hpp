@@ -0,0 +1,206 @@
+//
+// RecordRing.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_CONTAINER_RECORDRING_HPP_
+#define UTILITY_UTILITY_CONTAINER_RECORDRING_HPP_
+
+#include "utility/algorithm/Algorithm.hpp"
+#include "utility/container/Buffer.hpp"
+#include "utility/container/QueueCursors.hpp"
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+namespace Ut {
+namespace Ct {
+
+/// Byte-stream queue of variable-length records.
+///
+/// Records are stored contiguously, each one prefixed with its length, and
+/// aligned to `kAlignment`. A record never wraps around the end of the
+/// storage: when it does not fit in the remaining tail, the tail is marked as
+/// skipped, and the record is placed at the beginning. Therefore, every record
+/// is handed out as a single contiguous view into the storage, and consumed
+/// without copying.
+///
+/// \pre The storage must be aligned to `kAlignment`, and outlive the ring
+///
+/// \tparam CursorsType defines how read and write positions are synchronized,
+/// see `RingQueue`. By default, the ring is lock-free and thread safe for one
+/// producer and one consumer.
+template <class CursorsType = SpscQueueCursors>
+class RecordRing {
+private:
+	using HeaderType = std::uint32_t;
+	static constexpr HeaderType kSkipMarker = 0xFFFFFFFF;
+
+public:
+	static constexpr std::size_t kAlignment = sizeof(HeaderType);
+
+	/// Uses the largest power of 2 number of bytes that fits in `aBuffer`
+	explicit RecordRing(MemoryBuffer aBuffer) :
+		storage{reinterpret_cast<std::uint8_t *>(aBuffer.data())},
+		nBytes{Ut::Al::floorPow2(aBuffer.size())},
+		cursors{},
+		pendingPosition{0}
+	{
+		assert(reinterpret_cast<std::uintptr_t>(aBuffer.data()) % kAlignment == 0);
+		assert(nBytes >= 4 * kAlignment);
+	}
+
+	RecordRing(const RecordRing &) = delete;
+	RecordRing &operator=(const RecordRing &) = delete;
+
+	/// Reserves a contiguous region for a record of up to `aSize` bytes, so
+	/// the producer can fill it in place. The record becomes visible to the
+	/// consumer after `commit()`.
+	///
+	/// \returns the reserved region, or an empty buffer, if there is not
+	/// enough space
+	MemoryBuffer tryReserve(std::size_t aSize)
+	{
+		if (aSize > maxRecordSize()) {
+			return {nullptr, 0};
+		}
+
+		const std::size_t pushPosition = cursors.pushCursor();
+		const std::size_t offset = absolutePosition(pushPosition);
+		const std::size_t tail = nBytes - offset;
+		const std::size_t recordSize = alignedRecordSize(aSize);
+
+		if (recordSize <= tail) {
+			if (cursors.writable(nBytes, recordSize) < recordSize) {
+				return {nullptr, 0};
+			}
+
+			pendingPosition = pushPosition;
+		} else {
+			if (cursors.writable(nBytes, tail + recordSize) < tail + recordSize) {
+				return {nullptr, 0};
+			}
+
+			writeHeader(offset, kSkipMarker);
+			pendingPosition = pushPosition + tail;
+		}
+
+		return {storage + absolutePosition(pendingPosition) + sizeof(HeaderType), aSize};
+	}
+
+	/// Publishes the record obtained with `tryReserve`.
+	///
+	/// \pre `aSize` does not exceed the reserved size
+	void commit(std::size_t aSize)
+	{
+		writeHeader(absolutePosition(pendingPosition), static_cast<HeaderType>(aSize));
+		cursors.publishPush(pendingPosition + alignedRecordSize(aSize));
+	}
+
+	bool tryPush(ConstMemoryBuffer aRecord)
+	{
+		MemoryBuffer reserved = tryReserve(aRecord.size());
+
+		if (reserved.data() == nullptr) {
+			return false;
+		}
+
+		if (aRecord.size() > 0) {
+			memcpy(reserved.data(), aRecord.data(), aRecord.size());
+		}
+
+		commit(aRecord.size());
+
+		return true;
+	}
+
+	/// Provides a view of the oldest record in the storage. The record stays
+	/// in the ring until `release()` is called.
+	///
+	/// \returns the record, or an empty buffer with `nullptr` data, if the
+	/// ring is empty
+	ConstMemoryBuffer peek()
+	{
+		while (cursors.readable(sizeof(HeaderType)) > 0) {
+			const std::size_t popPosition = cursors.popCursor();
+			const std::size_t offset = absolutePosition(popPosition);
+			const HeaderType header = readHeader(offset);
+
+			if (header == kSkipMarker) {
+				cursors.publishPop(popPosition + nBytes - offset);
+			} else {
+				return {storage + offset + sizeof(HeaderType), header};
+			}
+		}
+
+		return {nullptr, 0};
+	}
+
+	/// Frees the record obtained with `peek`
+	void release()
+	{
+		const std::size_t popPosition = cursors.popCursor();
+		cursors.publishPop(popPosition + alignedRecordSize(readHeader(absolutePosition(popPosition))));
+	}
+
+	/// The largest record that is guaranteed to fit into an empty ring
+	std::size_t maxRecordSize() const
+	{
+		return nBytes / 2 - sizeof(HeaderType);
+	}
+
+	/// Number of bytes occupied by records, headers, and padding
+	std::size_t bytesUsed() const
+	{
+		return cursors.count();
+	}
+
+	std::size_t capacity() const
+	{
+		return nBytes;
+	}
+
+private:
+	/// Implements fast modulo `a % 2^N == a & (2^N - 1)`
+	std::size_t absolutePosition(std::size_t aAccumulatedPosition) const
+	{
+		return aAccumulatedPosition & (nBytes - 1);
+	}
+
+	static std::size_t alignedRecordSize(std::size_t aSize)
+	{
+		return (sizeof(HeaderType) + aSize + kAlignment - 1) & ~(kAlignment - 1);
+	}
+
+	void writeHeader(std::size_t aOffset, HeaderType aHeader)
+	{
+		memcpy(storage + aOffset, &aHeader, sizeof(HeaderType));
+	}
+
+	HeaderType readHeader(std::size_t aOffset) const
+	{
+		HeaderType header;
+		memcpy(&header, storage + aOffset, sizeof(HeaderType));
+
+		return header;
+	}
+
+private:
+	std::uint8_t *storage;
+	std::size_t nBytes;
+	CursorsType cursors;
+	std::size_t pendingPosition;  ///< Position of the record reserved by the producer
+};
+
+template <class CursorsType>
+constexpr typename RecordRing<CursorsType>::HeaderType RecordRing<CursorsType>::kSkipMarker;
+
+template <class CursorsType>
+constexpr std::size_t RecordRing<CursorsType>::kAlignment;
+
+}  // namespace Ct
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_CONTAINER_RECORDRING_HPP_
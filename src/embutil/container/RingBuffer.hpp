@@ -0,0 +1,90 @@
+//
+// RingBuffer.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_CONTAINER_RINGBUFFER_HPP_
+#define UTILITY_UTILITY_CONTAINER_RINGBUFFER_HPP_
+
+#include "utility/algorithm/Algorithm.hpp"
+#include "utility/container/Buffer.hpp"
+#include "utility/container/QueueCursors.hpp"
+#include "utility/container/QueueStatistics.hpp"
+#include "utility/container/RingQueue.hpp"
+#include <cassert>
+#include <cstdint>
+
+namespace Ut {
+namespace Ct {
+namespace Impl {
+
+template <class T>
+class BufferRingStorage {
+public:
+	BufferRingStorage(MemoryBuffer aBuffer) :
+		storage{reinterpret_cast<RingQueueChunk<T> *>(aBuffer.data())},
+		nChunks{Ut::Al::floorPow2(aBuffer.size() / sizeof(T))}
+	{
+		assert(reinterpret_cast<std::uintptr_t>(aBuffer.data()) % alignof(T) == 0);
+		assert(nChunks > 0);
+	}
+
+	RingQueueChunk<T> *chunks()
+	{
+		return storage;
+	}
+
+	const RingQueueChunk<T> *chunks() const
+	{
+		return storage;
+	}
+
+	std::size_t capacity() const
+	{
+		return nChunks;
+	}
+
+private:
+	RingQueueChunk<T> *storage;
+	std::size_t nChunks;
+};
+
+}  // namespace Impl
+
+/// Queue which stores its elements in a memory region provided by the caller,
+/// e.g. a static arena, or a hugepage region. Unlike `FixedSizeQueue`, the
+/// capacity is chosen at runtime, and the same template instance serves any
+/// capacity.
+///
+/// The capacity is the largest power of 2 number of elements that fits in the
+/// region, so indices are still calculated through masking.
+///
+/// \pre The region must be aligned for `T`, and outlive the queue
+///
+/// \tparam CursorsType defines how read and write positions are synchronized,
+/// see `RingQueue`. The queue is not thread safe by default.
+/// \tparam StatisticsType optional instrumentation, see `QueueStatistics`
+template <class T, class CursorsType = PlainQueueCursors, class StatisticsType = NoQueueStatistics>
+class RingBuffer : public RingQueue<T, Impl::BufferRingStorage<T>, CursorsType, StatisticsType> {
+public:
+	explicit RingBuffer(MemoryBuffer aBuffer) :
+		RingQueue<T, Impl::BufferRingStorage<T>, CursorsType, StatisticsType>{Impl::BufferRingStorage<T>{aBuffer}}
+	{
+		assert(StatisticsType::kNtimestampSlots == 0 || StatisticsType::kNtimestampSlots >= this->capacity());
+	}
+
+	RingBuffer(const RingBuffer &) = delete;
+	RingBuffer &operator=(const RingBuffer &) = delete;
+};
+
+/// Lock-free single producer single consumer queue over a caller-supplied
+/// memory region
+template <class T, class StatisticsType = NoQueueStatistics>
+using SpscRingBuffer = RingBuffer<T, SpscQueueCursors, StatisticsType>;
+
+}  // namespace Ct
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_CONTAINER_RINGBUFFER_HPP_
@@ -0,0 +1,431 @@
+//
+// RingQueue.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_CONTAINER_RINGQUEUE_HPP_
+#define UTILITY_UTILITY_CONTAINER_RINGQUEUE_HPP_
+
+#include "utility/container/QueueCursors.hpp"
+#include "utility/container/QueueStatistics.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace Ut {
+namespace Ct {
+
+/// Uninitialized memory for one element of a ring queue
+template <class T>
+using RingQueueChunk = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+/// Ring queue, the common part of `FixedSizeQueue` and `RingBuffer`.
+///
+/// \tparam StorageType provides `chunks()`, an array of `RingQueueChunk<T>`,
+/// and `capacity()`, the array's size, which must be a power of 2.
+/// \tparam CursorsType defines how read and write positions are synchronized.
+/// With `PlainQueueCursors` the queue is not thread safe, and must be
+/// protected externally. With `SpscQueueCursors` the queue is lock-free and
+/// thread safe for as long as there are only 2 threads operating on it: one
+/// reads, and the other one - pushes. Iteration and `forcePush` require
+/// exclusive access in either case.
+/// \tparam T is only required to be move constructible. `tryPop` and
+/// `tryPopN` additionally require it to be move assignable, `tryConsume`
+/// does not.
+/// \tparam StatisticsType instrumentation policy, see `QueueStatistics`. The
+/// default `NoQueueStatistics` compiles out completely.
+template <class T, class StorageType, class CursorsType, class StatisticsType = NoQueueStatistics>
+class RingQueue : private StatisticsType {
+private:
+	using MemoryChunk = RingQueueChunk<T>;
+
+public:
+	RingQueue() = default;
+
+	explicit RingQueue(const StorageType &aStorage) :
+		storage(aStorage),
+		cursors{}
+	{
+	}
+
+	/// Copies the elements, the copy gets its own statistics
+	RingQueue(const RingQueue &aOther) :
+		StatisticsType{},
+		storage(aOther.storage),
+		cursors{}
+	{
+		copyFrom(aOther);
+	}
+
+	RingQueue &operator=(const RingQueue &aOther)
+	{
+		if (this != &aOther) {
+			clear();
+			copyFrom(aOther);
+		}
+
+		return *this;
+	}
+
+	~RingQueue()
+	{
+		clear();
+	}
+
+	template <class OwnerType, class ItemType>
+	struct Iterator {
+
+		inline friend bool operator!=(const Iterator &aLhs, const Iterator &aRhs)
+		{
+			return aLhs.position != aRhs.position;
+		}
+
+		OwnerType &owner;
+		std::size_t position;
+
+		ItemType &operator*()
+		{
+			return *reinterpret_cast<ItemType *>(&owner.storage.chunks()[owner.absolutePosition(position)]);
+		}
+
+		/// Pre-increment overload
+		Iterator &operator++()
+		{
+			++position;
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			auto iterator = *this;
+			++position;
+
+			return iterator;
+		}
+	};
+
+	Iterator<RingQueue, T> begin()
+	{
+		return {*this, cursors.popCursor()};
+	}
+
+	Iterator<RingQueue, T> end()
+	{
+		return {*this, cursors.pushCursor()};
+	}
+
+	Iterator<const RingQueue, const T> cbegin() const
+	{
+		return {*this, cursors.popCursor()};
+	}
+
+	Iterator<const RingQueue, const T> cend() const
+	{
+		return {*this, cursors.pushCursor()};
+	}
+
+	void forcePush(const T &aInstance)
+	{
+		forceEmplace(aInstance);
+	}
+
+	void forcePush(T &&aInstance)
+	{
+		forceEmplace(std::move(aInstance));
+	}
+
+	/// Constructs an element from `aArgs`. If the queue is full, the oldest
+	/// element is destroyed in place to make room for it.
+	template <class ...Ts>
+	void forceEmplace(Ts &&...aArgs)
+	{
+		if (cursors.writable(storage.capacity(), 1) == 0) {
+			const std::size_t popPosition = cursors.popCursor();
+			reinterpret_cast<T *>(&storage.chunks()[absolutePosition(popPosition)])->~T();
+			cursors.publishPop(popPosition + 1);  // Dropped elements do not contribute to residency time
+
+			if (StatisticsType::kEnabled) {
+				StatisticsType::onForcedDrop();
+			}
+		}
+
+		tryEmplace(std::forward<Ts>(aArgs)...);
+	}
+
+	bool tryPush(const T &aInstance)
+	{
+		return tryEmplace(aInstance);
+	}
+
+	bool tryPush(T &&aInstance)
+	{
+		return tryEmplace(std::move(aInstance));
+	}
+
+	template <class ...Ts>
+	bool tryEmplace(Ts &&...aArgs)
+	{
+		if (cursors.writable(storage.capacity(), 1) > 0) {
+			const std::size_t pushPosition = cursors.pushCursor();
+			new (reinterpret_cast<void *>(&storage.chunks()[absolutePosition(pushPosition)])) T{std::forward<Ts>(aArgs)...};
+			publishPush(pushPosition, 1);
+
+			return true;
+		} else {
+			onPushFailed(1);
+
+			return false;
+		}
+	}
+
+	bool tryPop(T &ret)
+	{
+		if (cursors.readable(1) > 0) {
+			const std::size_t popPosition = cursors.popCursor();
+			T *element = reinterpret_cast<T *>(&storage.chunks()[absolutePosition(popPosition)]);
+			ret = std::move(*element);
+			element->~T();
+			publishPop(popPosition, 1);
+
+			return true;
+		}
+
+		return false;
+	}
+
+	/// Passes the oldest element to `aVisitor` as `T &`, and then destroys it
+	/// in place. The visitor may move from the element.
+	///
+	/// \returns false, if the queue is empty
+	template <class VisitorType>
+	bool tryConsume(VisitorType &&aVisitor)
+	{
+		if (cursors.readable(1) > 0) {
+			const std::size_t popPosition = cursors.popCursor();
+			T *element = reinterpret_cast<T *>(&storage.chunks()[absolutePosition(popPosition)]);
+			aVisitor(*element);
+			element->~T();
+			publishPop(popPosition, 1);
+
+			return true;
+		}
+
+		return false;
+	}
+
+	/// Default-initializes an element in the next free slot without publishing
+	/// it, so the producer can fill it in place. The element becomes visible
+	/// to the consumer after `commit()`.
+	///
+	/// \returns pointer to the element, or `nullptr`, if the queue is full
+	T *tryReserve()
+	{
+		if (cursors.writable(storage.capacity(), 1) > 0) {
+			return new (reinterpret_cast<void *>(&storage.chunks()[absolutePosition(cursors.pushCursor())])) T;
+		}
+
+		onPushFailed(1);
+
+		return nullptr;
+	}
+
+	/// Like `tryReserve()`, but constructs the element from `aArgs`
+	template <class T1, class ...Ts>
+	T *tryReserve(T1 &&aArg, Ts &&...aArgs)
+	{
+		if (cursors.writable(storage.capacity(), 1) > 0) {
+			return new (reinterpret_cast<void *>(&storage.chunks()[absolutePosition(cursors.pushCursor())]))
+				T{std::forward<T1>(aArg), std::forward<Ts>(aArgs)...};
+		}
+
+		onPushFailed(1);
+
+		return nullptr;
+	}
+
+	/// Publishes the element obtained with `tryReserve`
+	void commit()
+	{
+		publishPush(cursors.pushCursor(), 1);
+	}
+
+	/// Provides in-place access to the oldest element. The slot stays occupied
+	/// until `release()` is called.
+	///
+	/// \returns pointer to the element, or `nullptr`, if the queue is empty
+	T *peek()
+	{
+		if (cursors.readable(1) > 0) {
+			return reinterpret_cast<T *>(&storage.chunks()[absolutePosition(cursors.popCursor())]);
+		}
+
+		return nullptr;
+	}
+
+	/// Destroys the element obtained with `peek`, and frees its slot
+	void release()
+	{
+		const std::size_t popPosition = cursors.popCursor();
+		reinterpret_cast<T *>(&storage.chunks()[absolutePosition(popPosition)])->~T();
+		publishPop(popPosition, 1);
+	}
+
+	/// Pushes up to `aCount` elements from `aInstances`. The elements are
+	/// copied in at most 2 contiguous segments, and become visible to the
+	/// consumer all at once.
+	///
+	/// \returns Number of pushed elements
+	std::size_t tryPushN(const T *aInstances, std::size_t aCount)
+	{
+		const std::size_t nPush = std::min(aCount, cursors.writable(storage.capacity(), aCount));
+
+		if (nPush > 0) {
+			const std::size_t pushPosition = cursors.pushCursor();
+			const std::size_t offset = absolutePosition(pushPosition);
+			const std::size_t nFirst = std::min(nPush, storage.capacity() - offset);
+			copyIn(&storage.chunks()[offset], aInstances, nFirst, std::is_trivially_copyable<T>{});
+			copyIn(&storage.chunks()[0], aInstances + nFirst, nPush - nFirst, std::is_trivially_copyable<T>{});
+			publishPush(pushPosition, nPush);
+		}
+
+		if (nPush < aCount) {
+			onPushFailed(aCount - nPush);
+		}
+
+		return nPush;
+	}
+
+	/// Pops up to `aCount` elements into `aInstances` in at most 2 contiguous
+	/// segments, and releases the slots all at once.
+	///
+	/// \returns Number of popped elements
+	std::size_t tryPopN(T *aInstances, std::size_t aCount)
+	{
+		const std::size_t nPop = std::min(aCount, cursors.readable(aCount));
+
+		if (nPop > 0) {
+			const std::size_t popPosition = cursors.popCursor();
+			const std::size_t offset = absolutePosition(popPosition);
+			const std::size_t nFirst = std::min(nPop, storage.capacity() - offset);
+			moveOut(aInstances, &storage.chunks()[offset], nFirst, std::is_trivially_copyable<T>{});
+			moveOut(aInstances + nFirst, &storage.chunks()[0], nPop - nFirst, std::is_trivially_copyable<T>{});
+			publishPop(popPosition, nPop);
+		}
+
+		return nPop;
+	}
+
+	/// Number of elements stored in the queue
+	std::size_t count() const
+	{
+		return cursors.count();
+	}
+
+	std::size_t capacity() const
+	{
+		return storage.capacity();
+	}
+
+	const StatisticsType &statistics() const
+	{
+		return *this;
+	}
+
+private:
+	/// Implements fast modulo `a % 2^N == a & (2^N - 1)`
+	std::size_t absolutePosition(std::size_t aAccumulatedPosition) const
+	{
+		return aAccumulatedPosition & (storage.capacity() - 1);
+	}
+
+	/// Destroys every stored element. Statistics are not affected.
+	void clear()
+	{
+		const std::size_t popPosition = cursors.popCursor();
+		const std::size_t pushPosition = cursors.pushCursor();
+
+		for (std::size_t position = popPosition; position != pushPosition; ++position) {
+			reinterpret_cast<T *>(&storage.chunks()[absolutePosition(position)])->~T();
+		}
+
+		cursors.publishPop(pushPosition);
+	}
+
+	void copyFrom(const RingQueue &aOther)
+	{
+		for (auto it = aOther.cbegin(); it != aOther.cend(); ++it) {
+			new (reinterpret_cast<void *>(&storage.chunks()[absolutePosition(cursors.pushCursor())])) T{*it};
+			cursors.publishPush(cursors.pushCursor() + 1);
+		}
+	}
+
+	void publishPush(std::size_t aPushPosition, std::size_t aNelements)
+	{
+		if (StatisticsType::kEnabled) {
+			StatisticsType::onPush(aPushPosition, aPushPosition + aNelements, cursors.count() + aNelements);
+		}
+
+		cursors.publishPush(aPushPosition + aNelements);
+	}
+
+	void publishPop(std::size_t aPopPosition, std::size_t aNelements)
+	{
+		if (StatisticsType::kEnabled) {
+			StatisticsType::onPop(aPopPosition, aPopPosition + aNelements);
+		}
+
+		cursors.publishPop(aPopPosition + aNelements);
+	}
+
+	void onPushFailed(std::size_t aNelements)
+	{
+		if (StatisticsType::kEnabled) {
+			StatisticsType::onPushFailed(aNelements);
+		}
+	}
+
+	static void copyIn(MemoryChunk *aDestination, const T *aSource, std::size_t aCount, std::true_type)
+	{
+		if (aCount > 0) {
+			memcpy(reinterpret_cast<void *>(aDestination), reinterpret_cast<const void *>(aSource),
+				aCount * sizeof(T));
+		}
+	}
+
+	static void copyIn(MemoryChunk *aDestination, const T *aSource, std::size_t aCount, std::false_type)
+	{
+		for (std::size_t i = 0; i < aCount; ++i) {
+			new (reinterpret_cast<void *>(&aDestination[i])) T{aSource[i]};
+		}
+	}
+
+	static void moveOut(T *aDestination, MemoryChunk *aSource, std::size_t aCount, std::true_type)
+	{
+		if (aCount > 0) {
+			memcpy(reinterpret_cast<void *>(aDestination), reinterpret_cast<const void *>(aSource),
+				aCount * sizeof(T));
+		}
+	}
+
+	static void moveOut(T *aDestination, MemoryChunk *aSource, std::size_t aCount, std::false_type)
+	{
+		for (std::size_t i = 0; i < aCount; ++i) {
+			T *element = reinterpret_cast<T *>(&aSource[i]);
+			aDestination[i] = std::move(*element);
+			element->~T();
+		}
+	}
+
+private:
+	StorageType storage;
+	CursorsType cursors;
+};
+
+}  // namespace Ct
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_CONTAINER_RINGQUEUE_HPP_
@@ -0,0 +1,426 @@
+//
+// StridedBuffer.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_CONTAINER_STRIDEDBUFFER_HPP_
+#define UTILITY_UTILITY_CONTAINER_STRIDEDBUFFER_HPP_
+
+#include "utility/container/Buffer.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+namespace Ut {
+namespace Ct {
+
+/// Stride of `StridedBuffer` known at runtime only
+constexpr std::ptrdiff_t kDynamicStride = 0;
+
+namespace Impl {
+
+template <std::ptrdiff_t kStride>
+struct StrideHolder {
+	explicit StrideHolder(std::ptrdiff_t aStride)
+	{
+		assert(aStride == kStride);
+		(void)aStride;
+	}
+
+	constexpr std::ptrdiff_t stride() const
+	{
+		return kStride;
+	}
+};
+
+template <>
+struct StrideHolder<kDynamicStride> {
+	explicit StrideHolder(std::ptrdiff_t aStride) :
+		value{aStride}
+	{
+	}
+
+	std::ptrdiff_t stride() const
+	{
+		return value;
+	}
+
+	std::ptrdiff_t value;
+};
+
+}  // namespace Impl
+
+/// Random access iterator over every `stride`-th element. Keeps the position
+/// as an index, because a pointer `stride` elements past the last one would
+/// point beyond the array.
+template <class T>
+struct StridedIterator {
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = typename std::remove_const<T>::type;
+	using difference_type = std::ptrdiff_t;
+	using pointer = T *;
+	using reference = T &;
+
+	inline friend bool operator!=(const StridedIterator &aLhs, const StridedIterator &aRhs)
+	{
+		return aLhs.index != aRhs.index;
+	}
+
+	inline friend bool operator==(const StridedIterator &aLhs, const StridedIterator &aRhs)
+	{
+		return aLhs.index == aRhs.index;
+	}
+
+	inline friend bool operator<(const StridedIterator &aLhs, const StridedIterator &aRhs)
+	{
+		return aLhs.index < aRhs.index;
+	}
+
+	inline friend difference_type operator-(const StridedIterator &aLhs, const StridedIterator &aRhs)
+	{
+		return aLhs.index - aRhs.index;
+	}
+
+	inline friend bool operator>(const StridedIterator &aLhs, const StridedIterator &aRhs)
+	{
+		return aRhs < aLhs;
+	}
+
+	inline friend bool operator<=(const StridedIterator &aLhs, const StridedIterator &aRhs)
+	{
+		return !(aRhs < aLhs);
+	}
+
+	inline friend bool operator>=(const StridedIterator &aLhs, const StridedIterator &aRhs)
+	{
+		return !(aLhs < aRhs);
+	}
+
+	inline friend StridedIterator operator+(StridedIterator aIterator, difference_type aOffset)
+	{
+		return aIterator += aOffset;
+	}
+
+	inline friend StridedIterator operator+(difference_type aOffset, StridedIterator aIterator)
+	{
+		return aIterator += aOffset;
+	}
+
+	inline friend StridedIterator operator-(StridedIterator aIterator, difference_type aOffset)
+	{
+		return aIterator += -aOffset;
+	}
+
+	T *base;  ///< The first element of the view
+	std::ptrdiff_t index;
+	std::ptrdiff_t stride;
+
+	T &operator*() const
+	{
+		return base[index * stride];
+	}
+
+	T &operator[](difference_type aOffset) const
+	{
+		return base[(index + aOffset) * stride];
+	}
+
+	StridedIterator &operator+=(difference_type aOffset)
+	{
+		index += aOffset;
+
+		return *this;
+	}
+
+	StridedIterator &operator-=(difference_type aOffset)
+	{
+		return *this += -aOffset;
+	}
+
+	/// Pre-increment overload
+	StridedIterator &operator++()
+	{
+		++index;
+
+		return *this;
+	}
+
+	StridedIterator operator++(int)
+	{
+		auto iterator = *this;
+		++index;
+
+		return iterator;
+	}
+
+	StridedIterator &operator--()
+	{
+		--index;
+
+		return *this;
+	}
+
+	StridedIterator operator--(int)
+	{
+		auto iterator = *this;
+		--index;
+
+		return iterator;
+	}
+};
+
+/// Non-owning view of every `stride`-th element of an array, e.g. one
+/// channel of interleaved samples (xyzxyz...), or a column of an image.
+///
+/// \tparam kStride compile-time stride in elements of `T`. For
+/// `kStride == 1`, the iterator is a plain pointer, so loops over the view
+/// vectorize the same way loops over `Buffer` do. `kDynamicStride` makes the
+/// stride a runtime parameter.
+template <class T, std::ptrdiff_t kStride = kDynamicStride>
+class StridedBuffer : private Impl::StrideHolder<kStride> {
+public:
+	using Type = T;
+	using Iterator = typename std::conditional<kStride == 1, T *, StridedIterator<T>>::type;
+
+	StridedBuffer(T *aData, std::size_t aSize, std::ptrdiff_t aStride = kStride) :
+		Impl::StrideHolder<kStride>{aStride},
+		pointer{aData},
+		nElements{aSize}
+	{
+	}
+
+	/// Dense view of a `Buffer`
+	StridedBuffer(Buffer<T> aBuffer) :
+		Impl::StrideHolder<kStride>{1},
+		pointer{aBuffer.data()},
+		nElements{aBuffer.size()}
+	{
+		static_assert(kStride == 1 || kStride == kDynamicStride, "A `Buffer` is dense, its stride is 1");
+	}
+
+	T *data() const
+	{
+		return pointer;
+	}
+
+	std::size_t size() const
+	{
+		return nElements;
+	}
+
+	/// Distance between adjacent elements, in elements of `T`
+	std::ptrdiff_t stride() const
+	{
+		return Impl::StrideHolder<kStride>::stride();
+	}
+
+	T &operator[](std::size_t aPosition) const
+	{
+		return pointer[static_cast<std::ptrdiff_t>(aPosition) * stride()];
+	}
+
+	Iterator begin() const
+	{
+		return makeIterator(0, std::integral_constant<bool, kStride == 1>{});
+	}
+
+	Iterator end() const
+	{
+		return makeIterator(static_cast<std::ptrdiff_t>(nElements), std::integral_constant<bool, kStride == 1>{});
+	}
+
+	bool isContiguous() const
+	{
+		return stride() == 1 || nElements < 2;
+	}
+
+	/// \pre `isContiguous()`
+	Buffer<T> asBuffer() const
+	{
+		assert(isContiguous());
+
+		return {pointer, nElements};
+	}
+
+	/// Constructs a slice satisfying the given range [aOffsetBegin; aOffsetEnd)
+	StridedBuffer asSlice(std::size_t aOffsetBegin, std::size_t aOffsetEnd) const
+	{
+		assert(aOffsetBegin <= aOffsetEnd);
+		assert(aOffsetEnd <= nElements);
+
+		return {pointer + static_cast<std::ptrdiff_t>(aOffsetBegin) * stride(), aOffsetEnd - aOffsetBegin, stride()};
+	}
+
+	StridedBuffer asSlice(std::size_t aOffset) const
+	{
+		return asSlice(aOffset, nElements);
+	}
+
+	/// Every `aStep`-th element of this view
+	StridedBuffer<T> asStepped(std::size_t aStep) const
+	{
+		assert(aStep > 0);
+
+		return {pointer, (nElements + aStep - 1) / aStep, stride() * static_cast<std::ptrdiff_t>(aStep)};
+	}
+
+	/// Erases the compile-time stride
+	operator StridedBuffer<T>() const
+	{
+		return {pointer, nElements, stride()};
+	}
+
+private:
+	T *makeIterator(std::ptrdiff_t aIndex, std::true_type) const
+	{
+		return pointer + aIndex;
+	}
+
+	StridedIterator<T> makeIterator(std::ptrdiff_t aIndex, std::false_type) const
+	{
+		return {pointer, aIndex, stride()};
+	}
+
+private:
+	T *pointer;
+	std::size_t nElements;
+};
+
+/// Non-owning view of a 2D array with rows that may be padded, e.g. a camera
+/// frame in a DMA buffer. Rows are dense, so `row()` is a plain `Buffer`.
+template <class T>
+class Buffer2D {
+public:
+	using Type = T;
+
+	/// \arg aRowStride distance between the beginnings of adjacent rows, in
+	/// elements of `T`. Defaults to `aNcolumns`, i.e. no padding
+	Buffer2D(T *aData, std::size_t aNrows, std::size_t aNcolumns, std::size_t aRowStride = 0) :
+		pointer{aData},
+		nRows{aNrows},
+		nColumns{aNcolumns},
+		rowStride{aRowStride == 0 ? aNcolumns : aRowStride}
+	{
+		assert(rowStride >= nColumns);
+	}
+
+	T *data() const
+	{
+		return pointer;
+	}
+
+	std::size_t rows() const
+	{
+		return nRows;
+	}
+
+	std::size_t columns() const
+	{
+		return nColumns;
+	}
+
+	std::size_t stride() const
+	{
+		return rowStride;
+	}
+
+	/// Number of elements in the view, padding excluded
+	std::size_t size() const
+	{
+		return nRows * nColumns;
+	}
+
+	T &operator()(std::size_t aRow, std::size_t aColumn) const
+	{
+		return pointer[aRow * rowStride + aColumn];
+	}
+
+	Buffer<T> row(std::size_t aRow) const
+	{
+		assert(aRow < nRows);
+
+		return {pointer + aRow * rowStride, nColumns};
+	}
+
+	StridedBuffer<T> column(std::size_t aColumn) const
+	{
+		assert(aColumn < nColumns);
+
+		return {pointer + aColumn, nRows, static_cast<std::ptrdiff_t>(rowStride)};
+	}
+
+	/// Constructs a view of rows [aRowBegin; aRowEnd)
+	Buffer2D asSlice(std::size_t aRowBegin, std::size_t aRowEnd) const
+	{
+		return asSlice(aRowBegin, aRowEnd, 0, nColumns);
+	}
+
+	/// Constructs a view of the region [aRowBegin; aRowEnd) x [aColumnBegin; aColumnEnd)
+	Buffer2D asSlice(std::size_t aRowBegin, std::size_t aRowEnd, std::size_t aColumnBegin,
+		std::size_t aColumnEnd) const
+	{
+		assert(aRowBegin <= aRowEnd && aRowEnd <= nRows);
+		assert(aColumnBegin <= aColumnEnd && aColumnEnd <= nColumns);
+
+		return {pointer + aRowBegin * rowStride + aColumnBegin, aRowEnd - aRowBegin, aColumnEnd - aColumnBegin,
+			rowStride};
+	}
+
+	/// There is no padding between the rows
+	bool isContiguous() const
+	{
+		return rowStride == nColumns || nRows < 2;
+	}
+
+	/// \pre `isContiguous()`
+	Buffer<T> asBuffer() const
+	{
+		assert(isContiguous());
+
+		return {pointer, size()};
+	}
+
+private:
+	T *pointer;
+	std::size_t nRows;
+	std::size_t nColumns;
+	std::size_t rowStride;
+};
+
+/// Constructs a view of every `aStride`-th element of `aBuffer` starting from
+/// `aOffset`, e.g. `toStridedBuffer<const float>(imu, 1, 3)` is the Y channel
+/// of interleaved XYZ samples. The buffer is reinterpreted as `Tto` first,
+/// the same way as in `toBuffer`.
+template <class Tto, class Tfrom>
+inline StridedBuffer<Tto> toStridedBuffer(Buffer<Tfrom> aBuffer, std::size_t aOffset, std::size_t aStride)
+{
+	const Buffer<Tto> buffer = toBuffer<Tto>(aBuffer.data(), aBuffer.size());
+	assert(aStride > 0);
+	const std::size_t size = buffer.size() > aOffset ? (buffer.size() - aOffset + aStride - 1) / aStride : 0;
+
+	return {buffer.data() + aOffset, size, static_cast<std::ptrdiff_t>(aStride)};
+}
+
+/// Constructs a 2D view of `aBuffer` reinterpreted as `Tto`. The last row is
+/// allowed to lack the padding.
+///
+/// \arg aRowStride in elements of `Tto`, defaults to `aNcolumns`
+template <class Tto, class Tfrom>
+inline Buffer2D<Tto> toBuffer2D(Buffer<Tfrom> aBuffer, std::size_t aNcolumns, std::size_t aRowStride = 0)
+{
+	const Buffer<Tto> buffer = toBuffer<Tto>(aBuffer.data(), aBuffer.size());
+	const std::size_t rowStride = aRowStride == 0 ? aNcolumns : aRowStride;
+	assert(aNcolumns > 0 && rowStride >= aNcolumns);
+	const std::size_t nRows = buffer.size() >= aNcolumns ? (buffer.size() - aNcolumns) / rowStride + 1 : 0;
+
+	return {buffer.data(), nRows, aNcolumns, rowStride};
+}
+
+}  // namespace Ct
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_CONTAINER_STRIDEDBUFFER_HPP_
@@ -10,10 +10,12 @@
 
 #include "utility/OhDebug.hpp"
 #include "utility/algorithm/Time.hpp"
-#include "utility/algorithm/Vector.hpp"
+#include "utility/container/Buffer.hpp"
 #include "utility/snippet/LockWrapper.hpp"
 #include "utility/snippet/StubMutex.hpp"
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cstdint>
@@ -35,6 +37,30 @@ struct RequestHandler {
 	{
 		(void)aRequest;
 	}
+
+	/// Requests retried on one tick. Only invoked with
+	/// `LongRequestDispatch::OutsideLock`. Override it to coalesce writes.
+	virtual void retryRequests(Ut::Ct::Buffer<const RequestType> aRequests)
+	{
+		for (const RequestType &request : aRequests) {
+			retryRequest(request);
+		}
+	}
+
+	/// Requests expired on one tick. Only invoked with
+	/// `LongRequestDispatch::OutsideLock`
+	virtual void onRequestsExpired(Ut::Ct::Buffer<const RequestType> aRequests)
+	{
+		for (const RequestType &request : aRequests) {
+			onRequestExpired(request);
+		}
+	}
+};
+
+/// How `LongRequestQueue` invokes its `RequestHandler`
+enum class LongRequestDispatch {
+	UnderLock,  ///< Per-request callbacks, the queue stays locked while they run
+	OutsideLock,  ///< Due requests are collected into a batch, and dispatched once the queue is unlocked
 };
 
 /// Decorates a `RequestType` with time information
@@ -66,6 +92,9 @@ struct LongRequest {
 	/// Employs "not-less" timeout policy, meaning that an invoker should wait
 	/// AT LEAST `timeout` before issuing the next request, and use ALL
 	/// attempts.
+	///
+	/// `aNextTimeout` is 0 for expired requests only. A request that is due,
+	/// or has a zero timeout, reports 1.
 	UpdateResult tryUpdateUseAllAttempts(const TimeType &aNow, TimeType &aNextTimeout)
 	{
 		if (nReattemptsLeft == 0) {
@@ -75,17 +104,703 @@ struct LongRequest {
 		} else if (aNow > startTime + timeout) {
 			--nReattemptsLeft;
 			startTime = aNow;
-			aNextTimeout = timeout;
+			aNextTimeout = std::max<TimeType>(timeout, TimeType{1});
 
 			return UpdateResult::Invoke;
 		} else {
-			aNextTimeout = startTime + timeout - aNow;
+			// Due on the next tick, but 0 would be mistaken for "no timeout"
+			aNextTimeout = std::max<TimeType>(startTime + timeout - aNow, TimeType{1});
 
 			return UpdateResult::NoInvoke;
 		}
 	}
 };
 
+/// Identifies a request pushed into `LongRequestQueue`, so it can be
+/// cancelled in O(1), e.g. once its ACK arrives.
+///
+/// Slots of retired requests are reused. The generation tells a reused slot
+/// from the one the handle has been issued for, so a stale handle is
+/// ignored. A default-constructed handle is never valid.
+struct LongRequestHandle {
+	std::uint32_t index;
+	std::uint32_t generation;
+
+	/// false, if the request has never been queued, see
+	/// `LongRequestQueue::push`
+	bool isValid() const
+	{
+		return generation != 0;
+	}
+};
+
+namespace Impl {
+
+/// Generation 0 is never issued, see `LongRequestHandle`
+inline std::uint32_t nextGeneration(std::uint32_t aGeneration)
+{
+	return aGeneration == 0xFFFFFFFF ? 1 : aGeneration + 1;
+}
+
+}  // namespace Impl
+
+/// Plain array of requests. Every tick iterates over all of them, so
+/// `LongRequestQueue::onTick` costs O(n). Suits small queues best.
+///
+/// Handles refer to slots which track positions of the requests in the
+/// array, as these change on removal.
+template <class RequestType, class TimeType, std::size_t kInitialSize>
+class LongRequestVectorStorage {
+public:
+	using LongRequestType = LongRequest<RequestType, TimeType>;
+
+private:
+	static constexpr std::uint32_t kNil = 0xFFFFFFFF;
+
+	struct Entry {
+		LongRequestType longRequest;
+		std::uint32_t slot;
+	};
+
+	struct Slot {
+		std::uint32_t position;  ///< Position of the request, or the next free slot
+		std::uint32_t generation;
+	};
+
+public:
+	LongRequestVectorStorage() :
+		freeSlot{kNil}
+	{
+		requests.reserve(kInitialSize);
+		slots.reserve(kInitialSize);
+	}
+
+	std::size_t size() const
+	{
+		return requests.size();
+	}
+
+	LongRequestHandle push(const LongRequestType &aLongRequest)
+	{
+		std::uint32_t slot = freeSlot;
+
+		if (slot == kNil) {
+			slots.push_back(Slot{kNil, 1});
+			slot = static_cast<std::uint32_t>(slots.size() - 1);
+		} else {
+			freeSlot = slots[slot].position;
+		}
+
+		slots[slot].position = static_cast<std::uint32_t>(requests.size());
+		requests.push_back(Entry{aLongRequest, slot});
+
+		return {slot, slots[slot].generation};
+	}
+
+	/// \returns false, if the request has already been removed
+	bool cancel(LongRequestHandle aHandle)
+	{
+		if (aHandle.index >= slots.size() || slots[aHandle.index].generation != aHandle.generation) {
+			return false;
+		}
+
+		eraseAt(slots[aHandle.index].position);
+
+		return true;
+	}
+
+	/// \returns number of removed requests
+	template <class CallableType>
+	std::size_t removeIf(CallableType &&aCallable)
+	{
+		std::size_t ret = 0;
+
+		for (std::size_t i = 0; i < requests.size();) {
+			if (aCallable(requests[i].longRequest)) {
+				eraseAt(i);
+				++ret;
+			} else {
+				++i;
+			}
+		}
+
+		return ret;
+	}
+
+	/// Updates every request, and notifies `aCallback` of the ones which are
+	/// either to be retried, or have expired. The latter get removed.
+	///
+	/// `aCallback` must comply `void(const RequestType &, LongRequestType::UpdateResult)`
+	/// signature
+	///
+	/// \returns time before next timeout, or 0, if there are no pending requests
+	template <class CallbackType>
+	TimeType update(TimeType aNow, CallbackType &&aCallback)
+	{
+		TimeType minNextTimeout{0};
+
+		for (std::size_t i = 0; i < requests.size();) {
+			TimeType nextTimeout{0};
+			const auto updateResult = requests[i].longRequest.tryUpdateUseAllAttempts(aNow, nextTimeout);
+
+			if (updateResult == LongRequestType::UpdateResult::Invoke) {
+				aCallback(requests[i].longRequest.request, updateResult);
+				++i;
+			} else if (updateResult == LongRequestType::UpdateResult::Expired) {
+				aCallback(requests[i].longRequest.request, updateResult);
+				eraseAt(i);
+				OHDEBUG("Ut::Sn::LongRequestQueue", "removed expired long request, size() =", requests.size());
+			} else {
+				++i;
+			}
+
+			if (minNextTimeout == TimeType{0}) {
+				minNextTimeout = nextTimeout;
+			} else if (nextTimeout > TimeType{0} && nextTimeout < minNextTimeout) {
+				minNextTimeout = nextTimeout;
+			}
+		}
+
+		return minNextTimeout;
+	}
+
+private:
+	/// Swaps the request with the last one, and frees its slot
+	void eraseAt(std::size_t aPosition)
+	{
+		Slot &slot = slots[requests[aPosition].slot];
+		slot.generation = Impl::nextGeneration(slot.generation);
+		slot.position = freeSlot;
+		freeSlot = requests[aPosition].slot;
+
+		if (aPosition != requests.size() - 1) {
+			requests[aPosition] = requests.back();
+			slots[requests[aPosition].slot].position = static_cast<std::uint32_t>(aPosition);
+		}
+
+		requests.pop_back();
+	}
+
+private:
+	std::vector<Entry> requests;
+	std::vector<Slot> slots;
+	std::uint32_t freeSlot;  ///< Head of the list of free slots
+};
+
+template <class RequestType, class TimeType, std::size_t kInitialSize>
+constexpr std::uint32_t LongRequestVectorStorage<RequestType, TimeType, kInitialSize>::kNil;
+
+namespace Impl {
+
+inline unsigned highestBit(std::uint64_t aValue)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return 63U - static_cast<unsigned>(__builtin_clzll(aValue));
+#else
+	unsigned ret = 0;
+
+	while (aValue >>= 1) {
+		++ret;
+	}
+
+	return ret;
+#endif
+}
+
+inline unsigned lowestBit(std::uint64_t aValue)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<unsigned>(__builtin_ctzll(aValue));
+#else
+	unsigned ret = 0;
+
+	while ((aValue & 1) == 0) {
+		aValue >>= 1;
+		++ret;
+	}
+
+	return ret;
+#endif
+}
+
+template <class LongRequestType>
+struct LongRequestNode {
+	LongRequestType longRequest;
+	std::uint64_t due;  ///< The first moment at which the request is to be retried
+	std::uint32_t previous;
+	std::uint32_t next;
+	std::size_t list;
+	std::uint32_t generation;
+};
+
+/// Nodes in a `std::vector`, which grows on demand, and never shrinks
+template <class NodeType, std::size_t kInitialSize>
+class GrowingNodePool {
+public:
+	GrowingNodePool()
+	{
+		nodes.reserve(kInitialSize);
+	}
+
+	std::size_t size() const
+	{
+		return nodes.size();
+	}
+
+	NodeType &operator[](std::size_t aIndex)
+	{
+		return nodes[aIndex];
+	}
+
+	const NodeType &operator[](std::size_t aIndex) const
+	{
+		return nodes[aIndex];
+	}
+
+	/// Adds a node
+	bool tryGrow()
+	{
+		nodes.emplace_back();
+
+		return true;
+	}
+
+private:
+	std::vector<NodeType> nodes;
+};
+
+/// Nodes in place, no allocations
+template <class NodeType, std::size_t kCapacity>
+class FixedNodePool {
+	static_assert(kCapacity > 0 && kCapacity < 0xFFFFFFFF, "Node index must fit in 32 bits");
+
+public:
+	FixedNodePool() :
+		nUsed{0}
+	{
+	}
+
+	std::size_t size() const
+	{
+		return nUsed;
+	}
+
+	NodeType &operator[](std::size_t aIndex)
+	{
+		return nodes[aIndex];
+	}
+
+	const NodeType &operator[](std::size_t aIndex) const
+	{
+		return nodes[aIndex];
+	}
+
+	/// Takes one more node into use
+	///
+	/// \returns false, if the capacity has been exhausted
+	bool tryGrow()
+	{
+		if (nUsed == kCapacity) {
+			return false;
+		}
+
+		++nUsed;
+
+		return true;
+	}
+
+private:
+	std::array<NodeType, kCapacity> nodes;
+	std::size_t nUsed;
+};
+
+/// Hierarchical timer wheel. `push` and `cancel` cost O(1), and a tick only
+/// visits the requests which are due, so `LongRequestQueue::onTick` costs
+/// O(expired) regardless of the number of pending requests.
+///
+/// Time is measured in the units of `TimeType` (see `Ut::Al::timeToIntegral`).
+/// Each of the `kNlevels` levels has 64 slots, and a slot of level `l` spans
+/// 64^l units. A request is put on the lowest level on which its due time
+/// and the wheel's current time only differ in the slot digit. When the
+/// current time reaches a slot of a higher level, its requests are
+/// re-distributed over the lower ones (cascading). Occupied slots are
+/// tracked in a bitmap per level, so idle periods are skipped in one step.
+///
+/// Requests are kept in a pool of nodes (see `GrowingNodePool` and
+/// `FixedNodePool`) linked into per-slot lists.
+///
+/// `update` returns a lower bound of the time before the next timeout, so
+/// the caller may wake up slightly early, but never late.
+template <class RequestType, class TimeType, class NodePoolType>
+class LongRequestTimerWheel {
+public:
+	using LongRequestType = LongRequest<RequestType, TimeType>;
+
+private:
+	static constexpr unsigned kSlotBits = 6;
+	static constexpr std::size_t kNslots = 1 << kSlotBits;
+	static constexpr unsigned kNlevels = 11;  ///< 66 bits, covers the whole range of 64-bit time
+	static constexpr std::uint32_t kNil = 0xFFFFFFFF;
+	static constexpr std::size_t kNwheelLists = kNlevels * kNslots;
+	static constexpr std::size_t kFreeList = kNwheelLists;
+	static constexpr std::size_t kPendingList = kNwheelLists + 1;  ///< Updated on the next tick, regardless of time
+
+	using Node = LongRequestNode<LongRequestType>;
+
+public:
+	LongRequestTimerWheel() :
+		current{0},
+		nRequests{0},
+		minPendingTimeout{0}
+	{
+		heads.fill(kNil);
+		occupied.fill(0);
+	}
+
+	std::size_t size() const
+	{
+		return nRequests;
+	}
+
+	/// \returns invalid handle, if the node pool is exhausted
+	LongRequestHandle push(const LongRequestType &aLongRequest)
+	{
+		std::uint32_t index = kNil;
+
+		if (!tryAllocate(index)) {
+			return {kNil, 0};
+		}
+
+		if (nRequests == 0) {
+			current = toIntegral(aLongRequest.startTime);
+		}
+
+		nodes[index].longRequest = aLongRequest;
+		++nRequests;
+		schedule(index);
+
+		return {index, nodes[index].generation};
+	}
+
+	/// \returns false, if the request has already been removed
+	bool cancel(LongRequestHandle aHandle)
+	{
+		if (aHandle.index >= nodes.size() || nodes[aHandle.index].generation != aHandle.generation
+				|| nodes[aHandle.index].list == kFreeList) {
+			return false;
+		}
+
+		release(aHandle.index);
+
+		return true;
+	}
+
+	/// \returns number of removed requests
+	template <class CallableType>
+	std::size_t removeIf(CallableType &&aCallable)
+	{
+		std::size_t ret = 0;
+
+		for (std::uint32_t i = 0; i < nodes.size(); ++i) {
+			if (nodes[i].list != kFreeList && aCallable(nodes[i].longRequest)) {
+				release(i);
+				++ret;
+			}
+		}
+
+		return ret;
+	}
+
+	/// See `LongRequestVectorStorage::update`
+	template <class CallbackType>
+	TimeType update(TimeType aNow, CallbackType &&aCallback)
+	{
+		// Requests that have used up their attempts on the previous tick
+		std::uint32_t pending = detach(kPendingList);
+		minPendingTimeout = TimeType{0};
+
+		while (pending != kNil) {
+			const std::uint32_t next = nodes[pending].next;
+			invoke(pending, aNow, aCallback);
+			pending = next;
+		}
+
+		const std::uint64_t now = toIntegral(aNow);
+		std::uint64_t eventTime = 0;
+
+		while (nextEvent(eventTime) && eventTime <= now) {
+			current = eventTime;
+
+			for (unsigned level = kNlevels - 1; level > 0; --level) {
+				if (isSlotStart(eventTime, level)) {
+					expire(level, aNow, aCallback);
+				}
+			}
+
+			expire(0, aNow, aCallback);
+		}
+
+		if (now > current) {
+			current = now;
+		}
+
+		if (!nextEvent(eventTime)) {
+			return minPendingTimeout;
+		}
+
+		// `due` is 1 past the timeout milestone, see `schedule`
+		const TimeType nextTimeout(std::max<std::uint64_t>(eventTime - 1 - current, 1));
+
+		return minPendingTimeout == TimeType{0} || nextTimeout < minPendingTimeout ? nextTimeout : minPendingTimeout;
+	}
+
+private:
+	static std::uint64_t toIntegral(const TimeType &aTime)
+	{
+		return static_cast<std::uint64_t>(Ut::Al::timeToIntegral(aTime));
+	}
+
+	static unsigned shift(unsigned aLevel)
+	{
+		return aLevel * kSlotBits;
+	}
+
+	static bool isSlotStart(std::uint64_t aTime, unsigned aLevel)
+	{
+		return (aTime & ((std::uint64_t{1} << shift(aLevel)) - 1)) == 0;
+	}
+
+	std::size_t slotOf(std::uint64_t aTime, unsigned aLevel) const
+	{
+		return static_cast<std::size_t>((aTime >> shift(aLevel)) & (kNslots - 1));
+	}
+
+	/// Finds the earliest occupied slot
+	///
+	/// \returns false, if there are no requests in the wheel
+	bool nextEvent(std::uint64_t &aEventTime) const
+	{
+		bool found = false;
+
+		for (unsigned level = 0; level < kNlevels; ++level) {
+			const std::size_t slot = slotOf(current, level);
+			const std::uint64_t later = slot == kNslots - 1 ? 0 : occupied[level] & (~std::uint64_t{0} << (slot + 1));
+
+			if (later != 0) {
+				const unsigned blockShift = shift(level + 1);
+				const std::uint64_t blockStart = blockShift >= 64 ? 0 : current >> blockShift << blockShift;
+				const std::uint64_t eventTime = blockStart | (std::uint64_t{Impl::lowestBit(later)} << shift(level));
+
+				if (!found || eventTime < aEventTime) {
+					aEventTime = eventTime;
+					found = true;
+				}
+			}
+		}
+
+		return found;
+	}
+
+	/// Updates the requests of the slot which `current` has reached on
+	/// `aLevel`, and re-distributes the ones which are not due yet
+	template <class CallbackType>
+	void expire(unsigned aLevel, TimeType aNow, CallbackType &aCallback)
+	{
+		if ((occupied[aLevel] & (std::uint64_t{1} << slotOf(current, aLevel))) == 0) {
+			return;
+		}
+
+		std::uint32_t index = detach(aLevel * kNslots + slotOf(current, aLevel));
+
+		while (index != kNil) {
+			const std::uint32_t next = nodes[index].next;
+
+			if (nodes[index].due <= current) {
+				invoke(index, aNow, aCallback);
+			} else {
+				link(index);
+			}
+
+			index = next;
+		}
+	}
+
+	template <class CallbackType>
+	void invoke(std::uint32_t aIndex, TimeType aNow, CallbackType &aCallback)
+	{
+		TimeType nextTimeout{0};
+		const auto updateResult = nodes[aIndex].longRequest.tryUpdateUseAllAttempts(aNow, nextTimeout);
+
+		if (updateResult != LongRequestType::UpdateResult::NoInvoke) {
+			aCallback(nodes[aIndex].longRequest.request, updateResult);
+		}
+
+		// The last attempt is given its timeout before the request expires, the same way as in `LongRequestVectorStorage`
+		if (updateResult == LongRequestType::UpdateResult::Invoke && nodes[aIndex].longRequest.nReattemptsLeft == 0
+				&& (minPendingTimeout == TimeType{0} || nextTimeout < minPendingTimeout)) {
+			minPendingTimeout = nextTimeout;
+		}
+
+		if (updateResult == LongRequestType::UpdateResult::Expired) {
+			--nRequests;
+			nodes[aIndex].generation = Impl::nextGeneration(nodes[aIndex].generation);
+			pushFront(aIndex, kFreeList);
+			OHDEBUG("Ut::Sn::LongRequestQueue", "removed expired long request, size() =", nRequests);
+		} else {
+			schedule(aIndex);
+		}
+	}
+
+	/// Puts a detached node on the wheel according to its timeout
+	void schedule(std::uint32_t aIndex)
+	{
+		const LongRequestType &longRequest = nodes[aIndex].longRequest;
+
+		if (longRequest.nReattemptsLeft == 0) {
+			pushFront(aIndex, kPendingList);  // Expires on the next tick, as in `LongRequestVectorStorage`
+		} else {
+			// "Not-less" policy: retry once the milestone has been passed
+			nodes[aIndex].due = toIntegral(longRequest.startTime + longRequest.timeout) + 1;
+
+			if (nodes[aIndex].due <= current) {
+				pushFront(aIndex, kPendingList);  // Time has gone backwards
+			} else {
+				link(aIndex);
+			}
+		}
+	}
+
+	/// \pre `due > current`
+	void link(std::uint32_t aIndex)
+	{
+		const std::uint64_t due = nodes[aIndex].due;
+		const unsigned level = Impl::highestBit(due ^ current) / kSlotBits;
+		const std::size_t slot = slotOf(due, level);
+		occupied[level] |= std::uint64_t{1} << slot;
+		pushFront(aIndex, level * kNslots + slot);
+	}
+
+	void pushFront(std::uint32_t aIndex, std::size_t aList)
+	{
+		Node &node = nodes[aIndex];
+		node.list = aList;
+		node.previous = kNil;
+		node.next = heads[aList];
+
+		if (heads[aList] != kNil) {
+			nodes[heads[aList]].previous = aIndex;
+		}
+
+		heads[aList] = aIndex;
+	}
+
+	void unlink(std::uint32_t aIndex)
+	{
+		Node &node = nodes[aIndex];
+
+		if (node.previous == kNil) {
+			heads[node.list] = node.next;
+		} else {
+			nodes[node.previous].next = node.next;
+		}
+
+		if (node.next != kNil) {
+			nodes[node.next].previous = node.previous;
+		}
+
+		if (node.list < kNwheelLists && heads[node.list] == kNil) {
+			occupied[node.list / kNslots] &= ~(std::uint64_t{1} << (node.list % kNslots));
+		}
+	}
+
+	/// Empties a list
+	///
+	/// \returns the former head
+	std::uint32_t detach(std::size_t aList)
+	{
+		const std::uint32_t ret = heads[aList];
+		heads[aList] = kNil;
+
+		if (aList < kNwheelLists) {
+			occupied[aList / kNslots] &= ~(std::uint64_t{1} << (aList % kNslots));
+		}
+
+		return ret;
+	}
+
+	bool tryAllocate(std::uint32_t &aIndex)
+	{
+		if (heads[kFreeList] != kNil) {
+			aIndex = heads[kFreeList];
+			unlink(aIndex);
+
+			return true;
+		}
+
+		if (!nodes.tryGrow()) {
+			return false;
+		}
+
+		aIndex = static_cast<std::uint32_t>(nodes.size() - 1);
+		nodes[aIndex].generation = 1;
+
+		return true;
+	}
+
+	void release(std::uint32_t aIndex)
+	{
+		unlink(aIndex);
+		nodes[aIndex].generation = Impl::nextGeneration(nodes[aIndex].generation);
+		pushFront(aIndex, kFreeList);
+		--nRequests;
+	}
+
+private:
+	NodePoolType nodes;
+	std::array<std::uint32_t, kNwheelLists + 2> heads;
+	std::array<std::uint64_t, kNlevels> occupied;  ///< Bitmaps of non-empty slots
+	std::uint64_t current;  ///< Time up to which the wheel has been advanced
+	std::size_t nRequests;
+	TimeType minPendingTimeout;  ///< Over the requests which have used their last attempt during the current tick
+};
+
+template <class RequestType, class TimeType, class NodePoolType>
+constexpr std::uint32_t LongRequestTimerWheel<RequestType, TimeType, NodePoolType>::kNil;
+
+template <class RequestType, class TimeType, class NodePoolType>
+constexpr std::size_t LongRequestTimerWheel<RequestType, TimeType, NodePoolType>::kFreeList;
+
+template <class RequestType, class TimeType, class NodePoolType>
+constexpr std::size_t LongRequestTimerWheel<RequestType, TimeType, NodePoolType>::kPendingList;
+
+}  // namespace Impl
+
+/// Timer wheel (see `Impl::LongRequestTimerWheel`) with a node pool which
+/// grows on demand, and never shrinks. `push` and `cancel` cost O(1), and
+/// `LongRequestQueue::onTick` costs O(expired).
+template <class RequestType, class TimeType, std::size_t kInitialSize>
+class LongRequestTimerWheelStorage : public Impl::LongRequestTimerWheel<RequestType, TimeType,
+	Impl::GrowingNodePool<Impl::LongRequestNode<LongRequest<RequestType, TimeType>>, kInitialSize>> {
+};
+
+/// Timer wheel (see `Impl::LongRequestTimerWheel`) with all the nodes in
+/// place, so it never allocates. Once `kCapacity` requests are pending,
+/// `push` fails, see `LongRequestQueue::overflowCount`.
+///
+/// Every operation is bounded: `push` and `cancel` cost O(1), a tick costs
+/// O(expired) with at most `kCapacity` requests expiring.
+///
+/// Pass `LongRequestFixedStorage<kCapacity>::Storage` as the queue's
+/// `StorageType`. The capacity does not depend on the queue's `kInitialSize`.
+template <std::size_t kCapacity>
+struct LongRequestFixedStorage {
+	/// 	param kInitialSize ignored, all the nodes are in place
+	template <class RequestType, class TimeType, std::size_t kInitialSize>
+	class Storage : public Impl::LongRequestTimerWheel<RequestType, TimeType,
+		Impl::FixedNodePool<Impl::LongRequestNode<LongRequest<RequestType, TimeType>>, kCapacity>> {
+	};
+};
+
 /// An intermediate storage of encapsulated request entities that have a
 /// delayed answer, or might need to be reissued due to communication drops.
 ///
@@ -94,8 +809,23 @@ struct LongRequest {
 /// from time to time.
 ///
 /// \tparam RequestType must be a lightweight, as it will be copied multiple times
+/// \tparam kInitialSize number of requests the growing storages reserve
+/// memory for, and a tick is able to dispatch in
+/// `LongRequestDispatch::OutsideLock` mode without allocating
+/// \tparam StorageType storage policy, `LongRequestVectorStorage`,
+/// `LongRequestTimerWheelStorage`, or `LongRequestFixedStorage<N>::Storage`.
+/// The wheels pay off for thousands of requests. The fixed one never
+/// allocates, and has a capacity of its own
+/// \tparam kDispatch use `LongRequestDispatch::OutsideLock`, if the handler
+/// may block, e.g. on writing into a port, so `push` and `cancel` from other
+/// threads do not stall meanwhile. In that mode, the handler may also call
+/// `push`, `cancel`, `removeIf`, `size`, and `overflowCount`. Ticks are
+/// serialized with a separate mutex held during the dispatch, and reuse one
+/// batch, so the handler may not call `onTick`.
 template <class RequestType, class MutexType = Ut::Sn::StubMutex, class T = std::chrono::milliseconds,
-	std::size_t kInitialSize = 4>
+	std::size_t kInitialSize = 4,
+	template <class, class, std::size_t> class StorageType = LongRequestVectorStorage,
+	LongRequestDispatch kDispatch = LongRequestDispatch::UnderLock>
 class LongRequestQueue {
 	static_assert(std::is_copy_constructible<RequestType>::value, "The entity must be copy-constructible. "
 		"This assertion may also be triggered, if `RequestType` is an incomplete type");
@@ -108,15 +838,25 @@ public:
 	using LongRequestType = LongRequest<RequestType, TimeType>;
 
 private:
-	using LongRequestStorageType = std::vector<LongRequestType>;
+	using LongRequestStorageType = StorageType<RequestType, TimeType, kInitialSize>;
+
+	/// Requests collected on a tick, see `LongRequestDispatch::OutsideLock`
+	struct DispatchBatch {
+		std::vector<RequestType> retried;
+		std::vector<RequestType> expired;
+	};
 
 public:
 	LongRequestQueue() :
-		requestQueue{}
+		requestQueue{},
+		requestHandler{nullptr},
+		nOverflows{0},
+		dispatchBatch{}
 	{
-		auto lockedRequestQueue = requestQueue.makeLock();
-		lockedRequestQueue->reserve(kInitialSize);
-		lockedRequestQueue->clear();
+		if (kDispatch == LongRequestDispatch::OutsideLock) {
+			dispatchBatch.instanceUnsafe().retried.reserve(kInitialSize);
+			dispatchBatch.instanceUnsafe().expired.reserve(kInitialSize);
+		}
 	}
 
 	std::size_t size() const
@@ -124,19 +864,48 @@ public:
 		return requestQueue.instanceUnsafe().size();
 	}
 
-	void push(const RequestType &aRequestType, TimeType aTimeout, std::size_t aNattempts, TimeType aNow)
+	/// \returns handle for `cancel`. If the storage is out of capacity, the
+	/// handle is not valid, the request is not tried, and the overflow gets
+	/// counted, see `overflowCount`
+	LongRequestHandle push(const RequestType &aRequestType, TimeType aTimeout, std::size_t aNattempts, TimeType aNow)
 	{
 		auto lockedRequestQueue = requestQueue.makeLock();
-		lockedRequestQueue->push_back(LongRequestType{aRequestType, aNow, aTimeout, aNattempts});
+		const LongRequestHandle handle = lockedRequestQueue->push(LongRequestType{aRequestType, aNow, aTimeout,
+			aNattempts});
+
+		if (!handle.isValid()) {
+			nOverflows.fetch_add(1, std::memory_order_relaxed);
+			OHDEBUG("Ut::Sn::LongRequestQueue", "out of capacity, size() =", lockedRequestQueue->size());
+
+			return handle;
+		}
+
 		OHDEBUG("Ut::Sn::LongRequestQueue", "added long request, size() =", lockedRequestQueue->size());
+		RequestHandlerType *handler = requestHandler;
 
-		if (requestHandler != nullptr) {
-			requestHandler->retryRequest(lockedRequestQueue->back().request);
+		if (kDispatch == LongRequestDispatch::OutsideLock) {
+			lockedRequestQueue.forceReleaseLock();
 		}
+
+		if (handler != nullptr) {
+			handler->retryRequest(aRequestType);
+		}
+
+		return handle;
+	}
+
+	/// Removes the request in O(1), e.g. once its ACK arrives
+	///
+	/// \returns false, if the request has already expired, or been removed
+	bool cancel(LongRequestHandle aHandle)
+	{
+		auto lockedRequestQueue = requestQueue.makeLock();
+
+		return lockedRequestQueue->cancel(aHandle);
 	}
 
 	/// Iterates over the request queue and removes items that satisfy the
-	/// condition.
+	/// condition. Prefer `cancel` for removing individual requests.
 	///
 	/// `aCallable` condition checker, must comply `bool(RequestType &)`
 	/// signature
@@ -144,10 +913,17 @@ public:
 	void removeIf(CallableType &&aCallable)
 	{
 		auto lockedRequestQueue = requestQueue.makeLock();
-		Ut::Al::vectorSwapEraseIf(*lockedRequestQueue, std::move(aCallable));
+		lockedRequestQueue->removeIf(std::move(aCallable));
 		OHDEBUG("Ut::Sn::LongRequestQueue", "made an attempt to remove long request, size() =", lockedRequestQueue->size());
 	}
 
+	/// Number of requests rejected by `push` so far. May be polled from any
+	/// thread without taking the queue's lock
+	std::size_t overflowCount() const
+	{
+		return nOverflows.load(std::memory_order_relaxed);
+	}
+
 	void setRequestHandler(RequestHandlerType &aRequestHandler)
 	{
 		auto lockedRequestQueue = requestQueue.makeLock();
@@ -155,44 +931,78 @@ public:
 		requestHandler = &aRequestHandler;
 	}
 
-	/// Returns time before next timeout, or 0, if there are no pending requests
+	/// Returns time before next timeout, or 0, if there are no pending
+	/// requests. A due request yields 1 rather than 0, so the caller keeps
+	/// ticking
 	TimeType onTick(TimeType aNow)
 	{
+		return onTick(aNow, std::integral_constant<bool, kDispatch == LongRequestDispatch::OutsideLock>{});
+	}
+
+private:
+	/// Collects due requests, and dispatches them in batches once the queue
+	/// is unlocked. Retries are dispatched before expirations.
+	TimeType onTick(TimeType aNow, std::true_type)
+	{
+		auto lockedDispatchBatch = dispatchBatch.makeLock();
+		DispatchBatch &batch = *lockedDispatchBatch;
+		batch.retried.clear();
+		batch.expired.clear();
 		auto lockedRequestQueue = requestQueue.makeLock();
-		TimeType minNextTimeout{0};
 
-		// Cull expired, calculate `minNextTimeout`
-		if (lockedRequestQueue->size() > 0 && requestHandler != nullptr) {
-			for (std::size_t i = 0; i < lockedRequestQueue->size();) {
-				TimeType nextTimeout{0};
-				const auto updateResult = lockedRequestQueue->at(i).tryUpdateUseAllAttempts(aNow, nextTimeout);
-
-				if (updateResult == LongRequestType::UpdateResult::Invoke) {
-					requestHandler->retryRequest(lockedRequestQueue->at(i).request);
-					++i;
-				} else if (updateResult == LongRequestType::UpdateResult::Expired) {
-					requestHandler->onRequestExpired(lockedRequestQueue->at(i).request);
-					Ut::Al::vectorSwapEraseAt(*lockedRequestQueue, i);
-					OHDEBUG("Ut::Sn::LongRequestQueue", "removed expired long request, size() =",
-						lockedRequestQueue->size());
+		if (lockedRequestQueue->size() == 0 || requestHandler == nullptr) {
+			return TimeType{0};
+		}
+
+		RequestHandlerType &handler = *requestHandler;
+		const TimeType ret = lockedRequestQueue->update(aNow,
+			[&batch](const RequestType &aRequest, typename LongRequestType::UpdateResult aUpdateResult)
+			{
+				if (aUpdateResult == LongRequestType::UpdateResult::Invoke) {
+					batch.retried.push_back(aRequest);
 				} else {
-					++i;
+					batch.expired.push_back(aRequest);
 				}
+			});
+		lockedRequestQueue.forceReleaseLock();
 
-				if (minNextTimeout == TimeType{0}) {
-					minNextTimeout = nextTimeout;
-				} else if (nextTimeout > TimeType{0} && nextTimeout < minNextTimeout) {
-					minNextTimeout = nextTimeout;
-				}
-			}
+		if (!batch.retried.empty()) {
+			handler.retryRequests(Ut::Ct::toBuffer<const RequestType>(batch.retried));
 		}
 
-		return minNextTimeout;
+		if (!batch.expired.empty()) {
+			handler.onRequestsExpired(Ut::Ct::toBuffer<const RequestType>(batch.expired));
+		}
+
+		return ret;
+	}
+
+	TimeType onTick(TimeType aNow, std::false_type)
+	{
+		auto lockedRequestQueue = requestQueue.makeLock();
+
+		if (lockedRequestQueue->size() == 0 || requestHandler == nullptr) {
+			return TimeType{0};
+		}
+
+		RequestHandlerType &handler = *requestHandler;
+
+		return lockedRequestQueue->update(aNow,
+			[&handler](const RequestType &aRequest, typename LongRequestType::UpdateResult aUpdateResult)
+			{
+				if (aUpdateResult == LongRequestType::UpdateResult::Invoke) {
+					handler.retryRequest(aRequest);
+				} else {
+					handler.onRequestExpired(aRequest);
+				}
+			});
 	}
 
 private:
 	Ut::Sn::LockWrapper<LongRequestStorageType, MutexType> requestQueue;
 	RequestHandlerType *requestHandler;
+	std::atomic<std::size_t> nOverflows;
+	Ut::Sn::LockWrapper<DispatchBatch, MutexType> dispatchBatch;  ///< Locked for the whole tick
 };
 
 }  // namespace Sn
@@ -0,0 +1,243 @@
+//
+// ShardedLongRequestQueue.hpp
+//
+// Created on: Oct 17, 2026
+//     Author: agent (agent@local)
+//
+
+#ifndef UTILITY_UTILITY_SNIPPET_SHARDEDLONGREQUESTQUEUE_HPP_
+#define UTILITY_UTILITY_SNIPPET_SHARDEDLONGREQUESTQUEUE_HPP_
+
+#include "utility/snippet/LongRequestQueue.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Ut {
+namespace Sn {
+
+/// A set of `LongRequestQueue`s, one per link (e.g. a serial port), ticked by
+/// a pool of worker threads. Link `i` belongs to shard `i % nShards()`, and
+/// every shard is served by its own worker.
+///
+/// A worker sleeps until the earliest of the deadlines reported by its
+/// queues' `onTick`, instead of ticking at a fixed rate. `push` wakes the
+/// worker up, if the new request is due before that.
+///
+/// Time is measured with `std::chrono::steady_clock` from the construction
+/// of the object, see `now()`.
+///
+/// Retries and expirations are dispatched from the shard's worker thread,
+/// but the first attempt is made by `push` on the calling thread, so a
+/// handler must be safe to call from both. A queue without a handler is not
+/// ticked, until the handler is set.
+///
+/// \tparam T `std::chrono::duration`
+template <class RequestType, class T = std::chrono::milliseconds, std::size_t kInitialSize = 4,
+	template <class, class, std::size_t> class StorageType = LongRequestVectorStorage,
+	LongRequestDispatch kDispatch = LongRequestDispatch::UnderLock>
+class ShardedLongRequestQueue {
+public:
+	using QueueType = LongRequestQueue<RequestType, std::mutex, T, kInitialSize, StorageType, kDispatch>;
+	using RequestHandlerType = typename QueueType::RequestHandlerType;
+	using TimeType = T;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Shard {
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::thread worker;
+		bool isTicking = false;
+		bool isNotified = false;  ///< A request has been pushed while ticking, or before the wake up time
+		bool isStopping = false;
+		bool isIdle = true;  ///< No pending requests, sleeps until notified
+		TimeType wakeUpTime{0};
+	};
+
+public:
+	/// \arg aNshards number of worker threads, defaults to the number of cores
+	explicit ShardedLongRequestQueue(std::size_t aNlinks, std::size_t aNshards = 0) :
+		origin{Clock::now()},
+		queues(aNlinks),
+		shards(aNshards > 0 ? aNshards : std::max<std::size_t>(std::thread::hardware_concurrency(), 1))
+	{
+	}
+
+	~ShardedLongRequestQueue()
+	{
+		stop();
+	}
+
+	ShardedLongRequestQueue(const ShardedLongRequestQueue &) = delete;
+	ShardedLongRequestQueue &operator=(const ShardedLongRequestQueue &) = delete;
+
+	std::size_t nLinks() const
+	{
+		return queues.size();
+	}
+
+	std::size_t nShards() const
+	{
+		return shards.size();
+	}
+
+	/// Time elapsed since construction
+	TimeType now() const
+	{
+		return std::chrono::duration_cast<TimeType>(Clock::now() - origin);
+	}
+
+	void setRequestHandler(std::size_t aLink, RequestHandlerType &aRequestHandler)
+	{
+		assert(aLink < queues.size());
+		queues[aLink].setRequestHandler(aRequestHandler);
+		notify(shardOf(aLink), TimeType{0});
+	}
+
+	/// Spawns the workers. Requests pushed before that are tried right away
+	/// anyway, but timeouts are only tracked once the workers are running.
+	void start()
+	{
+		for (std::size_t i = 0; i < shards.size(); ++i) {
+			if (!shards[i].worker.joinable()) {
+				{
+					std::lock_guard<std::mutex> lock{shards[i].mutex};
+					shards[i].isStopping = false;
+				}
+
+				shards[i].worker = std::thread{&ShardedLongRequestQueue::run, this, i};
+			}
+		}
+	}
+
+	/// Joins the workers. Pending requests stay in the queues.
+	void stop()
+	{
+		for (Shard &shard : shards) {
+			{
+				std::lock_guard<std::mutex> lock{shard.mutex};
+				shard.isStopping = true;
+			}
+
+			shard.condition.notify_one();
+
+			if (shard.worker.joinable()) {
+				shard.worker.join();
+			}
+		}
+	}
+
+	/// See `LongRequestQueue::push`
+	LongRequestHandle push(std::size_t aLink, const RequestType &aRequest, TimeType aTimeout,
+		std::size_t aNattempts)
+	{
+		assert(aLink < queues.size());
+		const TimeType pushTime = now();
+		const LongRequestHandle handle = queues[aLink].push(aRequest, aTimeout, aNattempts, pushTime);
+
+		if (handle.isValid()) {
+			notify(shardOf(aLink), pushTime + aTimeout);
+		}
+
+		return handle;
+	}
+
+	/// See `LongRequestQueue::cancel`. The worker is not woken up, it will
+	/// find out on the next tick.
+	bool cancel(std::size_t aLink, LongRequestHandle aHandle)
+	{
+		assert(aLink < queues.size());
+
+		return queues[aLink].cancel(aHandle);
+	}
+
+	/// See `LongRequestQueue::removeIf`
+	template <class CallableType>
+	void removeIf(std::size_t aLink, CallableType &&aCallable)
+	{
+		assert(aLink < queues.size());
+		queues[aLink].removeIf(std::forward<CallableType>(aCallable));
+	}
+
+	std::size_t size(std::size_t aLink) const
+	{
+		assert(aLink < queues.size());
+
+		return queues[aLink].size();
+	}
+
+	std::size_t shardOf(std::size_t aLink) const
+	{
+		return aLink % shards.size();
+	}
+
+private:
+	/// Wakes the shard's worker up, if `aDeadline` comes before the time it
+	/// is going to wake up at
+	void notify(std::size_t aShard, TimeType aDeadline)
+	{
+		Shard &shard = shards[aShard];
+		std::unique_lock<std::mutex> lock{shard.mutex};
+
+		if (shard.isTicking || shard.isIdle || aDeadline < shard.wakeUpTime) {
+			shard.isNotified = true;
+			lock.unlock();
+			shard.condition.notify_one();
+		}
+	}
+
+	void run(std::size_t aShard)
+	{
+		Shard &shard = shards[aShard];
+		std::unique_lock<std::mutex> lock{shard.mutex};
+
+		while (!shard.isStopping) {
+			shard.isTicking = true;
+			shard.isNotified = false;
+			lock.unlock();
+			const TimeType tickTime = now();
+			TimeType nextTimeout{0};
+
+			for (std::size_t link = aShard; link < queues.size(); link += shards.size()) {
+				const TimeType timeout = queues[link].onTick(tickTime);
+
+				if (timeout > TimeType{0} && (nextTimeout == TimeType{0} || timeout < nextTimeout)) {
+					nextTimeout = timeout;
+				}
+			}
+
+			lock.lock();
+			shard.isTicking = false;
+
+			if (shard.isNotified) {
+				continue;  // A request has been pushed into a queue that has already been ticked
+			}
+
+			shard.isIdle = nextTimeout == TimeType{0};
+			shard.wakeUpTime = tickTime + nextTimeout;
+			auto isAwoken = [&shard]() { return shard.isNotified || shard.isStopping; };
+
+			if (shard.isIdle) {
+				shard.condition.wait(lock, isAwoken);
+			} else {
+				shard.condition.wait_until(lock, origin + shard.wakeUpTime, isAwoken);
+			}
+		}
+	}
+
+private:
+	Clock::time_point origin;
+	std::vector<QueueType> queues;
+	std::vector<Shard> shards;
+};
+
+}  // namespace Sn
+}  // namespace Ut
+
+#endif // UTILITY_UTILITY_SNIPPET_SHARDEDLONGREQUESTQUEUE_HPP_
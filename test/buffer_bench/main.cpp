@@ -0,0 +1,659 @@
+#define OHDEBUG_PORT_ENABLE 1
+#define OHDEBUG_TAGS_ENABLE "Bench"
+
+#include "utility/algorithm/ByteScan.hpp"
+#include "utility/algorithm/Crc.hpp"
+#include "utility/algorithm/Framing.hpp"
+#include "utility/container/Buffer.hpp"
+#include "utility/container/BufferChain.hpp"
+#include "utility/container/BufferPool.hpp"
+#include "utility/container/BufferStream.hpp"
+#include "utility/container/MappedBuffer.hpp"
+#include "utility/container/StridedBuffer.hpp"
+#include "utility/OhDebug.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kNbytes = 1 << 28;
+
+static std::vector<std::uint8_t> makeRandomBytes(std::size_t aSize)
+{
+	std::mt19937 generator{42};
+	std::vector<std::uint8_t> ret(aSize);
+
+	for (auto &byte : ret) {
+		byte = static_cast<std::uint8_t>(generator());
+	}
+
+	return ret;
+}
+
+/// Processes `kNbytes` in chunks of `aChunkSize`, e.g. protocol frames
+template <class CrcType>
+static void benchCrc(const char *aName, Ut::Al::CrcImplementation aImplementation, std::size_t aChunkSize)
+{
+	const auto data = makeRandomBytes(aChunkSize);
+	const auto chunk = Ut::Ct::toBuffer<const void>(data);
+	std::uint32_t checksum = 0;
+	const auto start = Clock::now();
+
+	for (std::size_t i = 0; i < kNbytes; i += aChunkSize) {
+		checksum += CrcType::compute(chunk, aImplementation);
+	}
+
+	const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", aName, "chunk", aChunkSize, "GB/s:", static_cast<double>(kNbytes) / seconds / 1e9, checksum);
+}
+
+OHDEBUG_TEST("CRC throughput")
+{
+	const std::size_t kChunkSizes[] = {64, 1500, 65536};
+
+	for (auto chunkSize : kChunkSizes) {
+		benchCrc<Ut::Al::Crc32>("CRC32 bytewise", Ut::Al::CrcImplementation::Bytewise, chunkSize);
+		benchCrc<Ut::Al::Crc32>("CRC32 slicing-by-8", Ut::Al::CrcImplementation::Slicing8, chunkSize);
+		benchCrc<Ut::Al::Crc32c>("CRC32C slicing-by-8", Ut::Al::CrcImplementation::Slicing8, chunkSize);
+		benchCrc<Ut::Al::Crc32c>("CRC32C SSE4.2", Ut::Al::CrcImplementation::Hardware, chunkSize);
+	}
+}
+
+/// Line-oriented sensor log: printable characters, a newline every ~80 bytes
+static std::vector<std::uint8_t> makeLog(std::size_t aSize)
+{
+	std::mt19937 generator{42};
+	std::vector<std::uint8_t> ret(aSize);
+
+	for (auto &byte : ret) {
+		byte = generator() % 80 == 0 ? '\n' : static_cast<std::uint8_t>(' ' + generator() % 90);
+	}
+
+	return ret;
+}
+
+OHDEBUG_TEST("Byte scanning throughput")
+{
+	constexpr std::size_t kLogSize = 1 << 24;
+	constexpr std::size_t kNpasses = 16;
+	const auto log = makeLog(kLogSize);
+	const auto copy = log;
+	const struct {
+		const char *name;
+		Ut::Al::ByteScanImplementation implementation;
+	} kImplementations[] = {
+		{"scalar", Ut::Al::ByteScanImplementation::Scalar},
+		{"SSE2", Ut::Al::ByteScanImplementation::Sse2},
+		{"AVX2", Ut::Al::ByteScanImplementation::Avx2},
+	};
+	const std::uint8_t kDelimiters[4] = {'\n', '\r', '$', '*'};
+
+	for (const auto &implementation : kImplementations) {
+		const auto &kernels = Ut::Al::byteScanKernels(implementation.implementation);
+		std::size_t checksum = 0;
+
+		// Line splitting, the way a frame parser does it
+		auto start = Clock::now();
+
+		for (std::size_t iPass = 0; iPass < kNpasses; ++iPass) {
+			for (std::size_t offset = 0; offset < kLogSize; ++offset) {
+				offset += kernels.find(log.data() + offset, kLogSize - offset, '\n');
+				++checksum;
+			}
+		}
+
+		double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		OHDEBUG("Bench", implementation.name, "find lines, GB/s:",
+			static_cast<double>(kNpasses * kLogSize) / seconds / 1e9, checksum);
+		start = Clock::now();
+
+		for (std::size_t iPass = 0; iPass < kNpasses; ++iPass) {
+			for (std::size_t offset = 0; offset < kLogSize; ++offset) {
+				offset += kernels.findAny(log.data() + offset, kLogSize - offset, kDelimiters);
+				++checksum;
+			}
+		}
+
+		seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		OHDEBUG("Bench", implementation.name, "findAny 4 delimiters, GB/s:",
+			static_cast<double>(kNpasses * kLogSize) / seconds / 1e9, checksum);
+		start = Clock::now();
+
+		for (std::size_t iPass = 0; iPass < kNpasses; ++iPass) {
+			checksum += kernels.count(log.data(), kLogSize, '\n');
+		}
+
+		seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		OHDEBUG("Bench", implementation.name, "count, GB/s:",
+			static_cast<double>(kNpasses * kLogSize) / seconds / 1e9, checksum);
+		start = Clock::now();
+
+		for (std::size_t iPass = 0; iPass < kNpasses; ++iPass) {
+			checksum += kernels.mismatch(log.data(), copy.data(), kLogSize);
+		}
+
+		seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		OHDEBUG("Bench", implementation.name, "mismatch, GB/s:",
+			static_cast<double>(kNpasses * kLogSize) / seconds / 1e9, checksum);
+	}
+}
+
+/// Header + payload + CRC: copied into one array and written, vs gathered
+/// with `writev`. Assembly is measured separately, as `/dev/null` does not
+/// read the data, and hides the cost of the copy a real sink would make.
+template <bool kSyscall>
+static void benchFrameTransmit(int aFileDescriptor)
+{
+	constexpr std::size_t kNframes = 1 << 20;
+	constexpr std::size_t kPayloadSize = 1400;
+	const auto payload = makeRandomBytes(kPayloadSize);
+	std::uint8_t header[16] = {0x55};
+	static std::uint8_t frame[sizeof(header) + kPayloadSize + sizeof(std::uint32_t)];
+	std::size_t checksum = 0;
+	auto start = Clock::now();
+
+	for (std::size_t i = 0; i < kNframes; ++i) {
+		const std::uint32_t crc = static_cast<std::uint32_t>(i);
+		memcpy(frame, header, sizeof(header));
+		memcpy(frame + sizeof(header), payload.data(), kPayloadSize);
+		memcpy(frame + sizeof(header) + kPayloadSize, &crc, sizeof(crc));
+		checksum += kSyscall ? static_cast<std::size_t>(write(aFileDescriptor, frame, sizeof(frame))) :
+			frame[i % sizeof(frame)];
+	}
+
+	double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", kSyscall ? "copy + write" : "copy", "Mframes/s:",
+		static_cast<double>(kNframes) / seconds / 1e6, checksum);
+	start = Clock::now();
+
+	for (std::size_t i = 0; i < kNframes; ++i) {
+		const std::uint32_t crc = static_cast<std::uint32_t>(i);
+		Ut::Ct::BufferChain<3> chain;
+		chain.append(Ut::Ct::toBuffer<const void>(payload));
+		chain.prepend(Ut::Ct::toBuffer<const void>(header, sizeof(header)));
+		chain.append(Ut::Ct::toBuffer<const void>(&crc, sizeof(crc)));
+		struct iovec iov[3];
+		const int nIov = static_cast<int>(chain.fillIovec(iov, 3));
+		checksum += kSyscall ? static_cast<std::size_t>(writev(aFileDescriptor, iov, nIov)) :
+			reinterpret_cast<std::uintptr_t>(iov[nIov - 1].iov_base) + iov[0].iov_len;
+	}
+
+	seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", kSyscall ? "BufferChain + writev" : "BufferChain", "Mframes/s:",
+		static_cast<double>(kNframes) / seconds / 1e6, checksum);
+}
+
+OHDEBUG_TEST("Frame transmit, contiguous copy vs BufferChain")
+{
+	const int fd = open("/dev/null", O_WRONLY);
+	benchFrameTransmit<false>(fd);
+	benchFrameTransmit<true>(fd);
+	close(fd);
+}
+
+constexpr std::size_t kFrameSize = 1536;
+using FramePool = Ut::Ct::BufferPool<kFrameSize, 256>;
+
+/// Every thread takes a frame buffer, touches it, and frees it, keeping a few
+/// frames in flight
+template <class AllocatorType>
+static void benchFrameAllocation(const char *aName, std::size_t aNthreads, AllocatorType &&aMakeAllocator)
+{
+	constexpr std::size_t kNframes = 1 << 21;
+	std::vector<std::thread> threads;
+	const auto start = Clock::now();
+
+	for (std::size_t iThread = 0; iThread < aNthreads; ++iThread) {
+		threads.emplace_back(
+			[&aMakeAllocator, aNthreads]()
+			{
+				auto allocator = aMakeAllocator();
+
+				for (std::size_t i = 0; i < kNframes / aNthreads; ++i) {
+					allocator(i);
+				}
+			});
+	}
+
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", aName, "threads", aNthreads, "Mframes/s:", static_cast<double>(kNframes) / seconds / 1e6);
+}
+
+OHDEBUG_TEST("Frame buffers, std::vector vs BufferPool")
+{
+	static FramePool pool;
+
+	for (std::size_t nThreads = 1; nThreads <= 4; nThreads *= 2) {
+		benchFrameAllocation("std::vector", nThreads,
+			[]()
+			{
+				return [](std::size_t aIteration)
+					{
+						static thread_local std::vector<std::uint8_t> inFlight[4];
+						inFlight[aIteration % 4] = std::vector<std::uint8_t>(kFrameSize);
+						inFlight[aIteration % 4][aIteration % kFrameSize] = 1;
+					};
+			});
+		benchFrameAllocation("BufferPool", nThreads,
+			[]()
+			{
+				return [](std::size_t aIteration)
+					{
+						static thread_local FramePool::Handle inFlight[4];
+						inFlight[aIteration % 4].reset();
+						inFlight[aIteration % 4] = pool.tryAllocate();
+						static_cast<std::uint8_t *>(inFlight[aIteration % 4].buffer().data())[aIteration % kFrameSize] = 1;
+					};
+			});
+		benchFrameAllocation("BufferPool + LocalCache", nThreads,
+			[]()
+			{
+				struct Allocator {
+					std::unique_ptr<FramePool::LocalCache<32>> cache;
+					FramePool::Handle inFlight[4];
+
+					void operator()(std::size_t aIteration)
+					{
+						FramePool::Handle &handle = inFlight[aIteration % 4];
+						cache->recycle(std::move(handle));
+						handle = cache->tryAllocate();
+						static_cast<std::uint8_t *>(handle.buffer().data())[aIteration % kFrameSize] = 1;
+					}
+				};
+
+				return Allocator{std::unique_ptr<FramePool::LocalCache<32>>{new FramePool::LocalCache<32>{pool}}, {}};
+			});
+	}
+
+	const auto statistics = pool.statistics();
+	OHDEBUG("Bench", "pool exhausted", statistics.nExhausted, "peak in use", statistics.peakInUse);
+}
+
+/// Sensor packet: sync, type, big endian length and timestamp, little endian
+/// floats. 20 bytes, so packets following each other are misaligned.
+struct SensorPacket {
+	std::uint8_t sync;
+	std::uint8_t type;
+	std::uint16_t length;
+	std::uint32_t timestamp;
+	float x;
+	float y;
+	float z;
+};
+
+/// The way it is done without `BufferReader`: a bounds check, a cast, and a swap per field
+static bool decodeManually(Ut::Ct::ConstMemoryBuffer aBuffer, SensorPacket &aPacket)
+{
+	const auto bytes = aBuffer.as<const std::uint8_t>();
+
+	if (bytes.size() < 2) {
+		return false;
+	}
+
+	aPacket.sync = bytes.data()[0];
+	aPacket.type = bytes.data()[1];
+
+	if (bytes.size() < 4) {
+		return false;
+	}
+
+	aPacket.length = __builtin_bswap16(*reinterpret_cast<const std::uint16_t *>(bytes.asSlice(2).data()));
+
+	if (bytes.size() < 8) {
+		return false;
+	}
+
+	aPacket.timestamp = __builtin_bswap32(*reinterpret_cast<const std::uint32_t *>(bytes.asSlice(4).data()));
+
+	if (bytes.size() < 20) {
+		return false;
+	}
+
+	aPacket.x = *reinterpret_cast<const float *>(bytes.asSlice(8).data());
+	aPacket.y = *reinterpret_cast<const float *>(bytes.asSlice(12).data());
+	aPacket.z = *reinterpret_cast<const float *>(bytes.asSlice(16).data());
+
+	return true;
+}
+
+static bool decodeWithReader(Ut::Ct::ConstMemoryBuffer aBuffer, SensorPacket &aPacket)
+{
+	Ut::Ct::BufferReader reader{aBuffer};
+
+	return reader.readFields(aPacket.sync, aPacket.type)
+		&& reader.readFields<Ut::Ct::Endianness::Big>(aPacket.length, aPacket.timestamp)
+		&& reader.readFields(aPacket.x, aPacket.y, aPacket.z);
+}
+
+template <class DecoderType>
+static void benchDecode(const char *aName, DecoderType &&aDecoder)
+{
+	constexpr std::size_t kPacketSize = 20;
+	constexpr std::size_t kNpackets = 1 << 16;
+	constexpr std::size_t kNpasses = 64;
+	const auto stream = makeRandomBytes(kPacketSize * kNpackets + 1);
+	double checksum = 0;
+	const auto start = Clock::now();
+
+	for (std::size_t iPass = 0; iPass < kNpasses; ++iPass) {
+		for (std::size_t i = 0; i < kNpackets; ++i) {
+			SensorPacket packet;
+
+			if (aDecoder(Ut::Ct::toBuffer<const void>(stream.data() + 1 + i * kPacketSize, kPacketSize), packet)) {
+				checksum += packet.length + packet.timestamp + packet.type + static_cast<double>(packet.z > 0.0f);
+			}
+		}
+	}
+
+	const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", aName, "Mpackets/s:", static_cast<double>(kNpasses * kNpackets) / seconds / 1e6, checksum);
+}
+
+OHDEBUG_TEST("Packet decoding, manual vs BufferReader")
+{
+	benchDecode("manual", decodeManually);
+	benchDecode("BufferReader", decodeWithReader);
+}
+
+/// Bytewise SLIP decoder, as typically found in drivers
+class NaiveSlipDecoder {
+public:
+	template <class CallbackType>
+	void feed(Ut::Ct::ConstMemoryBuffer aChunk, CallbackType &&aOnFrame)
+	{
+		for (std::uint8_t byte : aChunk.as<const std::uint8_t>()) {
+			if (byte == 0xC0) {
+				if (nBytes > 0) {
+					aOnFrame(Ut::Ct::ConstMemoryBuffer{frame, nBytes});
+				}
+
+				nBytes = 0;
+				escape = false;
+			} else if (byte == 0xDB) {
+				escape = true;
+			} else if (nBytes < sizeof(frame)) {
+				frame[nBytes++] = escape ? (byte == 0xDC ? 0xC0 : 0xDB) : byte;
+				escape = false;
+			}
+		}
+	}
+
+private:
+	std::uint8_t frame[2048];
+	std::size_t nBytes = 0;
+	bool escape = false;
+};
+
+/// Bytewise COBS decoder, as typically found in drivers
+class NaiveCobsDecoder {
+public:
+	template <class CallbackType>
+	void feed(Ut::Ct::ConstMemoryBuffer aChunk, CallbackType &&aOnFrame)
+	{
+		for (std::uint8_t byte : aChunk.as<const std::uint8_t>()) {
+			if (byte == 0) {
+				if (inFrame && nRemaining == 0) {
+					aOnFrame(Ut::Ct::ConstMemoryBuffer{frame, nBytes});
+				}
+
+				nBytes = 0;
+				nRemaining = 0;
+				zeroPending = false;
+				inFrame = false;
+			} else if (nRemaining == 0) {
+				if (zeroPending && nBytes < sizeof(frame)) {
+					frame[nBytes++] = 0;
+				}
+
+				nRemaining = byte - 1U;
+				zeroPending = byte != 0xFF;
+				inFrame = true;
+			} else {
+				if (nBytes < sizeof(frame)) {
+					frame[nBytes++] = byte;
+				}
+
+				--nRemaining;
+			}
+		}
+	}
+
+private:
+	std::uint8_t frame[2048];
+	std::size_t nBytes = 0;
+	std::size_t nRemaining = 0;
+	bool zeroPending = false;
+	bool inFrame = false;
+};
+
+/// Stream of telemetry frames, `aEscapeRate` of bytes need stuffing
+template <class EncoderType>
+static std::vector<std::uint8_t> makeFramedStream(std::size_t aSize, std::size_t aFrameSize, unsigned aEscapeRate,
+	std::size_t (*aBound)(std::size_t))
+{
+	std::mt19937 generator{42};
+	std::vector<std::uint8_t> stream;
+	std::vector<std::uint8_t> frame(aFrameSize);
+	std::vector<std::uint8_t> encoded(aBound(aFrameSize));
+
+	while (stream.size() < aSize) {
+		for (auto &byte : frame) {
+			byte = static_cast<std::uint8_t>(generator() % 0xBF + 1);  // No special bytes
+
+			if (aEscapeRate > 0 && generator() % aEscapeRate == 0) {
+				const std::uint8_t kSpecial[] = {0x00, 0xC0, 0xDB};
+				byte = kSpecial[generator() % 3];
+			}
+		}
+
+		EncoderType encoder{Ut::Ct::toBuffer<void>(encoded)};
+		encoder.update(Ut::Ct::toBuffer<const void>(frame));
+		const auto result = encoder.finish();
+		const auto *data = static_cast<const std::uint8_t *>(result.data());
+		stream.insert(stream.end(), data, data + result.size());
+	}
+
+	return stream;
+}
+
+template <class DecoderType>
+static void benchFrameDecoder(const char *aName, const std::vector<std::uint8_t> &aStream, std::size_t aChunkSize)
+{
+	constexpr std::size_t kNpasses = 16;
+	DecoderType decoder;
+	std::size_t nFrames = 0;
+	std::size_t checksum = 0;
+	const auto start = Clock::now();
+
+	for (std::size_t iPass = 0; iPass < kNpasses; ++iPass) {
+		for (std::size_t offset = 0; offset < aStream.size(); offset += aChunkSize) {
+			decoder.feed(Ut::Ct::toBuffer<const void>(aStream.data() + offset,
+				std::min(aChunkSize, aStream.size() - offset)),
+				[&](Ut::Ct::ConstMemoryBuffer aFrame)
+				{
+					++nFrames;
+					checksum += aFrame.size() + static_cast<const std::uint8_t *>(aFrame.data())[0];
+				});
+		}
+	}
+
+	const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", aName, "chunk", aChunkSize, "MB/s:",
+		static_cast<double>(kNpasses * aStream.size()) / seconds / 1e6, nFrames, checksum);
+}
+
+/// Chunk sizes model the input rates: a UART at ~1 MB/s hands out a few
+/// dozen bytes per read, a DMA-driven link at ~1 GB/s hands out large
+/// blocks.
+OHDEBUG_TEST("Framing, decoding throughput")
+{
+	constexpr std::size_t kStreamSize = 1 << 24;
+
+	for (unsigned escapeRate : {0, 64}) {
+		const auto slip = makeFramedStream<Ut::Al::SlipEncoder>(kStreamSize, 512, escapeRate,
+			Ut::Al::slipEncodedSizeBound);
+		const auto cobs = makeFramedStream<Ut::Al::CobsEncoder>(kStreamSize, 512, escapeRate,
+			Ut::Al::cobsEncodedSizeBound);
+		OHDEBUG("Bench", "512-byte frames, 1 byte of", escapeRate, "needs stuffing (0 - none)");
+
+		for (std::size_t chunkSize : {32, 4096, 65536}) {
+			benchFrameDecoder<NaiveSlipDecoder>("bytewise SLIP", slip, chunkSize);
+			benchFrameDecoder<Ut::Al::SlipDecoder<2048>>("SlipDecoder", slip, chunkSize);
+			benchFrameDecoder<NaiveCobsDecoder>("bytewise COBS", cobs, chunkSize);
+			benchFrameDecoder<Ut::Al::CobsDecoder<2048>>("CobsDecoder", cobs, chunkSize);
+		}
+	}
+}
+
+OHDEBUG_TEST("Framing, encoding throughput")
+{
+	constexpr std::size_t kNpasses = 1 << 15;
+	auto frame = makeRandomBytes(1024);
+	std::vector<std::uint8_t> encoded(Ut::Al::slipEncodedSizeBound(frame.size()));
+	std::size_t checksum = 0;
+	auto start = Clock::now();
+
+	for (std::size_t i = 0; i < kNpasses; ++i) {
+		Ut::Al::SlipEncoder encoder{Ut::Ct::toBuffer<void>(encoded)};
+		encoder.update(Ut::Ct::toBuffer<const void>(frame));
+		checksum += encoder.finish().size();
+	}
+
+	double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", "SlipEncoder, random bytes, MB/s:", static_cast<double>(kNpasses * frame.size()) / seconds / 1e6,
+		checksum);
+	start = Clock::now();
+
+	for (std::size_t i = 0; i < kNpasses; ++i) {
+		Ut::Al::CobsEncoder encoder{Ut::Ct::toBuffer<void>(encoded)};
+		encoder.update(Ut::Ct::toBuffer<const void>(frame));
+		checksum += encoder.finish().size();
+	}
+
+	seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", "CobsEncoder, random bytes, MB/s:", static_cast<double>(kNpasses * frame.size()) / seconds / 1e6,
+		checksum);
+}
+
+/// Calibration (scale and bias) of one channel of interleaved XYZ samples,
+/// in place
+template <class ProcessType>
+static void benchChannel(const char *aName, ProcessType &&aProcess)
+{
+	constexpr std::size_t kNsamples = 1 << 16;
+	constexpr std::size_t kNpasses = 2048;
+	std::vector<float> samples(3 * kNsamples);
+
+	for (std::size_t i = 0; i < samples.size(); ++i) {
+		samples[i] = static_cast<float>(i % 1000) * 0.01f;
+	}
+
+	const auto start = Clock::now();
+
+	for (std::size_t iPass = 0; iPass < kNpasses; ++iPass) {
+		aProcess(samples, 1.0001f, -0.0001f);
+	}
+
+	const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", aName, "Msamples/s:", static_cast<double>(kNpasses * kNsamples) / seconds / 1e6, samples[4]);
+}
+
+OHDEBUG_TEST("Interleaved channel, copy-out vs StridedBuffer")
+{
+	std::vector<float> scratch;
+	benchChannel("copy-out",
+		[&scratch](std::vector<float> &aSamples, float aScale, float aBias)
+		{
+			scratch.resize(aSamples.size() / 3);
+
+			for (std::size_t i = 0; i < scratch.size(); ++i) {
+				scratch[i] = aSamples[3 * i + 1];
+			}
+
+			for (float &value : scratch) {
+				value = value * aScale + aBias;
+			}
+
+			for (std::size_t i = 0; i < scratch.size(); ++i) {
+				aSamples[3 * i + 1] = scratch[i];
+			}
+		});
+	benchChannel("StridedBuffer",
+		[](std::vector<float> &aSamples, float aScale, float aBias)
+		{
+			for (float &value : Ut::Ct::toStridedBuffer<float>(Ut::Ct::toBuffer<float>(aSamples), 1, 3)) {
+				value = value * aScale + aBias;
+			}
+		});
+	// Planar layout, unit stride: the view must not be slower than a raw buffer
+	benchChannel("planar Buffer",
+		[](std::vector<float> &aSamples, float aScale, float aBias)
+		{
+			for (float &value : Ut::Ct::toBuffer<float>(aSamples.data(), aSamples.size() / 3)) {
+				value = value * aScale + aBias;
+			}
+		});
+	benchChannel("planar StridedBuffer<float, 1>",
+		[](std::vector<float> &aSamples, float aScale, float aBias)
+		{
+			for (float &value : Ut::Ct::StridedBuffer<float, 1>{aSamples.data(), aSamples.size() / 3}) {
+				value = value * aScale + aBias;
+			}
+		});
+}
+
+/// Log replay: time until the parser can start, and until the whole log is
+/// scanned. The file is in the page cache, as it is right after recording.
+OHDEBUG_TEST("Log replay, fread vs MappedBuffer")
+{
+	constexpr std::size_t kLogSize = 1 << 27;
+	const char *kPath = "/tmp/buffer_bench_log";
+	{
+		const auto log = makeLog(kLogSize);
+		FILE *file = fopen(kPath, "wb");
+		fwrite(log.data(), 1, log.size(), file);
+		fclose(file);
+	}
+
+	auto start = Clock::now();
+	{
+		FILE *file = fopen(kPath, "rb");
+		std::vector<std::uint8_t> log(kLogSize);
+		const std::size_t nRead = fread(log.data(), 1, log.size(), file);
+		fclose(file);
+		const double ready = std::chrono::duration<double>(Clock::now() - start).count();
+		const std::size_t nLines = Ut::Al::count(Ut::Ct::toBuffer<const void>(log.data(), nRead), '\n');
+		const double done = std::chrono::duration<double>(Clock::now() - start).count();
+		OHDEBUG("Bench", "fread: ready, ms", ready * 1e3, "scanned, ms", done * 1e3, nLines);
+	}
+	start = Clock::now();
+	{
+		Ut::Ct::MappedBuffer log{kPath};
+		log.advise(Ut::Ct::MappedBufferAdvice::Sequential);
+		const double ready = std::chrono::duration<double>(Clock::now() - start).count();
+		const std::size_t nLines = Ut::Al::count(log.buffer(), '\n');
+		const double done = std::chrono::duration<double>(Clock::now() - start).count();
+		OHDEBUG("Bench", "MappedBuffer: ready, ms", ready * 1e3, "scanned, ms", done * 1e3, nLines);
+	}
+
+	remove(kPath);
+}
+
+int main(void)
+{
+	OHDEBUG_RUN_TESTS();
+	return 0;
+}
@@ -0,0 +1,734 @@
+#define OHDEBUG_PORT_ENABLE 1
+#define OHDEBUG_TAGS_ENABLE "Trace"
+
+#include "utility/algorithm/ByteScan.hpp"
+#include "utility/algorithm/Crc.hpp"
+#include "utility/algorithm/Framing.hpp"
+#include "utility/container/Buffer.hpp"
+#include "utility/container/BufferChain.hpp"
+#include "utility/container/BufferPool.hpp"
+#include "utility/container/BufferStream.hpp"
+#include "utility/container/MappedBuffer.hpp"
+#include "utility/container/StridedBuffer.hpp"
+#include "utility/OhDebug.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__)
+# include <cstdlib>
+# include <sys/uio.h>
+# include <unistd.h>
+#endif
+
+static std::vector<std::uint8_t> makeRandomBytes(std::size_t aSize, unsigned aSeed)
+{
+	std::mt19937 generator{aSeed};
+	std::vector<std::uint8_t> ret(aSize);
+
+	for (auto &byte : ret) {
+		byte = static_cast<std::uint8_t>(generator());
+	}
+
+	return ret;
+}
+
+OHDEBUG_TEST("CRC, check values")
+{
+	const char kCheck[] = "123456789";
+	const auto check = Ut::Ct::toBuffer<const void>(kCheck, 9);
+	const Ut::Al::CrcImplementation kImplementations[] = {
+		Ut::Al::CrcImplementation::Bytewise,
+		Ut::Al::CrcImplementation::Slicing8,
+		Ut::Al::CrcImplementation::Hardware,
+		Ut::Al::CrcImplementation::Auto,
+	};
+
+	for (auto implementation : kImplementations) {
+		assert(Ut::Al::Crc32::compute(check, implementation) == 0xCBF43926);
+		assert(Ut::Al::Crc32c::compute(check, implementation) == 0xE3069283);
+	}
+
+	assert(Ut::Al::Crc32::compute(check) == OHDEBUG_COMPILE_TIME_CRC32_STR("123456789"));
+	assert(Ut::Al::Crc32::compute(Ut::Ct::toBuffer<const void>(kCheck, 0)) == 0);
+	assert(Ut::Al::Crc32{Ut::Al::CrcImplementation::Hardware}.selectedImplementation()
+		== Ut::Al::CrcImplementation::Slicing8);
+	OHDEBUG("Trace", "CRC32C hardware path", Ut::Al::cpuFeatures().sse42);
+}
+
+OHDEBUG_TEST("CRC, implementations agree on every length and alignment")
+{
+	const auto data = makeRandomBytes(1024, 1);
+
+	for (std::size_t offset = 0; offset < 8; ++offset) {
+		for (std::size_t size = 0; size + offset <= 300; ++size) {
+			const auto buffer = Ut::Ct::toBuffer<const void>(data.data() + offset, size);
+			const auto crc32 = Ut::Al::Crc32::compute(buffer, Ut::Al::CrcImplementation::Bytewise);
+			const auto crc32c = Ut::Al::Crc32c::compute(buffer, Ut::Al::CrcImplementation::Bytewise);
+			assert(Ut::Al::Crc32::compute(buffer, Ut::Al::CrcImplementation::Slicing8) == crc32);
+			assert(Ut::Al::Crc32c::compute(buffer, Ut::Al::CrcImplementation::Slicing8) == crc32c);
+			assert(Ut::Al::Crc32c::compute(buffer, Ut::Al::CrcImplementation::Hardware) == crc32c);
+		}
+	}
+}
+
+OHDEBUG_TEST("CRC, streaming update")
+{
+	const auto data = makeRandomBytes(4096, 2);
+	const auto whole = Ut::Al::Crc32c::compute(Ut::Ct::toBuffer<const void>(data));
+	std::mt19937 generator{3};
+	Ut::Al::Crc32c crc;
+
+	for (int iAttempt = 0; iAttempt < 2; ++iAttempt) {
+		std::size_t offset = 0;
+
+		while (offset < data.size()) {
+			const std::size_t size = std::min<std::size_t>(generator() % 100, data.size() - offset);
+			crc.update(Ut::Ct::toBuffer<const void>(data.data() + offset, size));
+			offset += size;
+		}
+
+		assert(crc.value() == whole);
+		crc.reset();
+	}
+}
+
+template <class EncoderType>
+static std::vector<std::uint8_t> encodeFrame(const std::vector<std::uint8_t> &aFrame, std::size_t aBound,
+	std::size_t aChunkSize)
+{
+	std::vector<std::uint8_t> encoded(aBound);
+	EncoderType encoder{Ut::Ct::toBuffer<void>(encoded)};
+
+	for (std::size_t offset = 0; offset < aFrame.size(); offset += aChunkSize) {
+		assert(encoder.update(Ut::Ct::toBuffer<const void>(aFrame.data() + offset,
+			std::min(aChunkSize, aFrame.size() - offset))));
+	}
+
+	const Ut::Ct::ConstMemoryBuffer result = encoder.finish();
+	assert(result.data() != nullptr);
+	encoded.resize(result.size());
+
+	return encoded;
+}
+
+/// Feeds `aStream` in chunks of `aChunkSize`
+template <class DecoderType>
+static std::vector<std::vector<std::uint8_t>> decodeStream(DecoderType &aDecoder,
+	const std::vector<std::uint8_t> &aStream, std::size_t aChunkSize)
+{
+	std::vector<std::vector<std::uint8_t>> frames;
+
+	for (std::size_t offset = 0; offset < aStream.size(); offset += aChunkSize) {
+		aDecoder.feed(Ut::Ct::toBuffer<const void>(aStream.data() + offset,
+			std::min(aChunkSize, aStream.size() - offset)),
+			[&frames](Ut::Ct::ConstMemoryBuffer aFrame)
+			{
+				const auto *data = static_cast<const std::uint8_t *>(aFrame.data());
+				frames.emplace_back(data, data + aFrame.size());
+			});
+	}
+
+	return frames;
+}
+
+OHDEBUG_TEST("COBS, reference vectors")
+{
+	struct Vector {
+		std::vector<std::uint8_t> decoded;
+		std::vector<std::uint8_t> encoded;
+	};
+	std::vector<Vector> vectors{
+		{{}, {0x01, 0x00}},
+		{{0x00}, {0x01, 0x01, 0x00}},
+		{{0x00, 0x00}, {0x01, 0x01, 0x01, 0x00}},
+		{{0x11, 0x22, 0x00, 0x33}, {0x03, 0x11, 0x22, 0x02, 0x33, 0x00}},
+		{{0x11, 0x22, 0x33, 0x44}, {0x05, 0x11, 0x22, 0x33, 0x44, 0x00}},
+		{{0x11, 0x00, 0x00, 0x00}, {0x02, 0x11, 0x01, 0x01, 0x01, 0x00}},
+	};
+	Vector longRun;  // 0x01..0xFF
+
+	for (unsigned i = 1; i <= 0xFF; ++i) {
+		longRun.decoded.push_back(static_cast<std::uint8_t>(i));
+	}
+
+	longRun.encoded.push_back(0xFF);
+	longRun.encoded.insert(longRun.encoded.end(), longRun.decoded.begin(), longRun.decoded.end() - 1);
+	longRun.encoded.insert(longRun.encoded.end(), {0x02, 0xFF, 0x00});
+	vectors.push_back(longRun);
+
+	for (const auto &vector : vectors) {
+		for (std::size_t chunkSize = 1; chunkSize <= vector.decoded.size() + 1; chunkSize += 1 + chunkSize / 4) {
+			assert(encodeFrame<Ut::Al::CobsEncoder>(vector.decoded,
+				Ut::Al::cobsEncodedSizeBound(vector.decoded.size()), chunkSize) == vector.encoded);
+		}
+
+		Ut::Al::CobsDecoder<512> decoder;
+		const auto frames = decodeStream(decoder, vector.encoded, vector.encoded.size());
+		assert(frames.size() == 1 && frames[0] == vector.decoded);
+	}
+}
+
+OHDEBUG_TEST("COBS and SLIP, streaming round trip")
+{
+	std::mt19937 generator{7};
+	std::vector<std::vector<std::uint8_t>> frames;
+	std::vector<std::uint8_t> cobsStream;
+	std::vector<std::uint8_t> slipStream;
+
+	for (std::size_t i = 0; i < 200; ++i) {
+		auto frame = makeRandomBytes(1 + generator() % 700, static_cast<unsigned>(i));
+
+		// Plenty of bytes to be stuffed
+		for (auto &byte : frame) {
+			const std::uint8_t kSpecial[] = {0x00, 0xC0, 0xDB};
+
+			if (generator() % 8 == 0) {
+				byte = kSpecial[generator() % 3];
+			}
+		}
+
+		const auto cobs = encodeFrame<Ut::Al::CobsEncoder>(frame, Ut::Al::cobsEncodedSizeBound(frame.size()), 97);
+		const auto slip = encodeFrame<Ut::Al::SlipEncoder>(frame, Ut::Al::slipEncodedSizeBound(frame.size()), 97);
+		assert(Ut::Al::count(Ut::Ct::toBuffer<const void>(cobs.data(), cobs.size() - 1), 0) == 0);
+		assert(Ut::Al::count(Ut::Ct::toBuffer<const void>(slip.data(), slip.size() - 1), 0xC0) == 0);
+		cobsStream.insert(cobsStream.end(), cobs.begin(), cobs.end());
+		slipStream.insert(slipStream.end(), slip.begin(), slip.end());
+		frames.push_back(std::move(frame));
+	}
+
+	for (std::size_t chunkSize : {1, 2, 3, 64, 255, 1000, 1 << 20}) {
+		Ut::Al::CobsDecoder<1024> cobsDecoder;
+		assert(decodeStream(cobsDecoder, cobsStream, chunkSize) == frames);
+		assert(cobsDecoder.statistics().nFrames == frames.size());
+		Ut::Al::SlipDecoder<1024> slipDecoder;
+		assert(decodeStream(slipDecoder, slipStream, chunkSize) == frames);
+		assert(slipDecoder.statistics().nFrames == frames.size());
+	}
+}
+
+OHDEBUG_TEST("COBS and SLIP, zero-copy frames and errors")
+{
+	// A short frame without special bytes is not copied
+	const std::uint8_t kCobs[] = {0x03, 0x11, 0x22, 0x00};
+	Ut::Al::CobsDecoder<16> cobsDecoder;
+	const void *frameData = nullptr;
+	cobsDecoder.feed(Ut::Ct::toBuffer<const void>(kCobs, sizeof(kCobs)),
+		[&frameData](Ut::Ct::ConstMemoryBuffer aFrame) { frameData = aFrame.data(); });
+	assert(frameData == kCobs + 1);
+
+	const std::uint8_t kSlip[] = {0xC0, 0x11, 0x22, 0xC0};
+	Ut::Al::SlipDecoder<16> slipDecoder;
+	slipDecoder.feed(Ut::Ct::toBuffer<const void>(kSlip, sizeof(kSlip)),
+		[&frameData](Ut::Ct::ConstMemoryBuffer aFrame) { frameData = aFrame.data(); });
+	assert(frameData == kSlip + 1);
+	assert(slipDecoder.statistics().nFrames == 1);  // The leading END makes no frame
+
+	// Errors only drop the frame they occur in
+	const std::vector<std::uint8_t> cobsStream{
+		0x05, 0x11, 0x00,  // Block cut short
+		0x03, 0x11, 0x22, 0x02, 0x33, 0x00,
+		0x10, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x00,  // Too long
+		0x02, 0x44, 0x00,
+	};
+	Ut::Al::CobsDecoder<8> smallCobsDecoder;
+	const auto cobsFrames = decodeStream(smallCobsDecoder, cobsStream, 1);
+	assert((cobsFrames == std::vector<std::vector<std::uint8_t>>{{0x11, 0x22, 0x00, 0x33}, {0x44}}));
+	assert(smallCobsDecoder.statistics().nMalformed == 1 && smallCobsDecoder.statistics().nOverflows == 1);
+
+	const std::vector<std::uint8_t> slipStream{
+		0x11, 0xDB, 0x01, 0xC0,  // Invalid escape
+		0x22, 0xDB, 0xC0,  // ESC END
+		0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xC0,  // Too long
+		0x33, 0xDB, 0xDC, 0xDB, 0xDD, 0xC0,
+	};
+	Ut::Al::SlipDecoder<8> smallSlipDecoder;
+	const auto slipFrames = decodeStream(smallSlipDecoder, slipStream, 1);
+	assert((slipFrames == std::vector<std::vector<std::uint8_t>>{{0x33, 0xC0, 0xDB}}));
+	assert(smallSlipDecoder.statistics().nMalformed == 2 && smallSlipDecoder.statistics().nOverflows == 1);
+
+	// Insufficient destination
+	std::uint8_t destination[4];
+	Ut::Al::CobsEncoder encoder{Ut::Ct::toBuffer<void>(destination, sizeof(destination))};
+	const std::uint8_t kPayload[] = {1, 2, 3, 4, 5};
+	assert(!encoder.update(Ut::Ct::toBuffer<const void>(kPayload, sizeof(kPayload))));
+	assert(encoder.finish().data() == nullptr);
+}
+
+OHDEBUG_TEST("Byte scanning kernels against the scalar version")
+{
+	const Ut::Al::ByteScanImplementation kImplementations[] = {
+		Ut::Al::ByteScanImplementation::Sse2,
+		Ut::Al::ByteScanImplementation::Avx2,
+	};
+	const auto &scalar = Ut::Al::byteScanKernels(Ut::Al::ByteScanImplementation::Scalar);
+	std::mt19937 generator{4};
+	std::vector<std::uint8_t> lhs(1024);
+	std::vector<std::uint8_t> rhs(1024);
+
+	for (int iAttempt = 0; iAttempt < 2000; ++iAttempt) {
+		const std::size_t size = generator() % 600;
+		const std::size_t offset = generator() % 32;
+		const unsigned alphabet = 1 + generator() % 255;  // Small alphabets produce lots of matches
+
+		for (std::size_t i = 0; i < size + offset; ++i) {
+			lhs[i] = static_cast<std::uint8_t>(generator() % alphabet);
+			rhs[i] = generator() % 64 == 0 ? static_cast<std::uint8_t>(generator()) : lhs[i];
+		}
+
+		const std::uint8_t needles[4] = {
+			static_cast<std::uint8_t>(generator() % alphabet),
+			static_cast<std::uint8_t>(generator() % 256),
+			static_cast<std::uint8_t>(generator() % alphabet),
+			static_cast<std::uint8_t>(generator() % 256),
+		};
+		const std::uint8_t *data = lhs.data() + offset;
+
+		for (auto implementation : kImplementations) {
+			const auto &kernels = Ut::Al::byteScanKernels(implementation);
+			assert(kernels.find(data, size, needles[0]) == scalar.find(data, size, needles[0]));
+			assert(kernels.findAny(data, size, needles) == scalar.findAny(data, size, needles));
+			assert(kernels.count(data, size, needles[0]) == scalar.count(data, size, needles[0]));
+			assert(kernels.mismatch(data, rhs.data() + offset, size)
+				== scalar.mismatch(data, rhs.data() + offset, size));
+		}
+	}
+
+	OHDEBUG("Trace", "SSE2", Ut::Al::cpuFeatures().sse2, "AVX2", Ut::Al::cpuFeatures().avx2);
+}
+
+OHDEBUG_TEST("Byte scanning over buffers")
+{
+	static const char kLog[] = "$GPGGA,123519,4807.038,N*47\r\n$GPRMC,225446,A*68\r\n";
+	const auto log = Ut::Ct::toBuffer<const char>(kLog, sizeof(kLog) - 1);
+	const std::size_t newline = Ut::Al::find(log, '\n');
+	assert(kLog[newline] == '\n' && newline == static_cast<std::size_t>(strchr(kLog, '\n') - kLog));
+	assert(Ut::Al::find(log, '#') == log.size());
+	assert(Ut::Al::findAny(log, '*', ',') == 6);
+	assert(Ut::Al::findAny(log.asSlice(7), '*', '\r', '\n', '$') == strcspn(kLog + 7, "*\r\n$"));
+	assert(Ut::Al::count(log, '$') == 2);
+	assert(Ut::Al::count(Ut::Ct::toBuffer<const char>(kLog, 0), '$') == 0);
+
+	const char kShort[] = "$GPGGA";
+	const auto prefix = Ut::Ct::toBuffer<const void>(kShort, 6);
+	assert(Ut::Al::equal(prefix, log.asSlice(0, 6)));
+	assert(!Ut::Al::equal(prefix, log));
+	assert(Ut::Al::compare(prefix, log) < 0);
+	assert(Ut::Al::compare(log, prefix) > 0);
+	assert(Ut::Al::compare(log.asSlice(1), log) > 0);  // 'G' > '$'
+	assert(Ut::Al::mismatch(log, log.asSlice(1)) == 0);
+}
+
+OHDEBUG_TEST("Buffer chain, assembly and slicing")
+{
+	static const char kHeader[] = "HDR";
+	static const char kPayload[] = "payload";
+	static const char kCrc[] = "CRC";
+	Ut::Ct::BufferChain<4> chain;
+	assert(chain.append(Ut::Ct::toBuffer<const void>(kPayload, 7)));
+	assert(chain.append(Ut::Ct::toBuffer<const void>(kCrc, 0)));  // Empty segments are skipped
+	assert(chain.append(Ut::Ct::toBuffer<const void>(kCrc, 3)));
+	assert(chain.prepend(Ut::Ct::toBuffer<const void>(kHeader, 3)));
+	assert(chain.segmentCount() == 3);
+	assert(chain.size() == 13);
+	assert(std::string(chain.begin(), chain.end()) == "HDRpayloadCRC");
+
+	for (std::size_t begin = 0; begin <= chain.size(); ++begin) {
+		for (std::size_t end = begin; end <= chain.size(); ++end) {
+			const auto slice = chain.asSlice(begin, end);
+			assert(slice.size() == end - begin);
+			assert(std::string(slice.begin(), slice.end()) == std::string("HDRpayloadCRC").substr(begin, end - begin));
+		}
+	}
+
+	assert(chain.asSlice(2, 11).segmentCount() == 3);
+	assert(chain.asSlice(3, 10).segmentCount() == 1);
+	char flat[8] = {0};
+	assert(chain.asSlice(5).copyTo(Ut::Ct::toBuffer<void>(flat, sizeof(flat))) == 8);
+	assert(memcmp(flat, "yloadCRC", 8) == 0);
+
+	// Fill up from both sides
+	assert(chain.append(Ut::Ct::toBuffer<const void>(kCrc, 1)));
+	assert(!chain.prepend(Ut::Ct::toBuffer<const void>(kCrc, 1)));
+	chain.clear();
+
+	for (int i = 0; i < 4; ++i) {
+		assert(chain.prepend(Ut::Ct::toBuffer<const void>(kPayload + 3 - i, 1)));
+	}
+
+	assert(!chain.append(Ut::Ct::toBuffer<const void>(kCrc, 1)));
+	assert(std::string(chain.begin(), chain.end()) == "payl");
+
+	// Alternating sides, the segments wrap around the storage
+	chain.clear();
+	assert(chain.append(Ut::Ct::toBuffer<const void>(kPayload + 2, 1)));
+	assert(chain.prepend(Ut::Ct::toBuffer<const void>(kPayload + 1, 1)));
+	assert(chain.append(Ut::Ct::toBuffer<const void>(kPayload + 3, 1)));
+	assert(chain.prepend(Ut::Ct::toBuffer<const void>(kPayload, 1)));
+	assert(std::string(chain.begin(), chain.end()) == "payl");
+	assert(std::string(chain.asSlice(1, 3).begin(), chain.asSlice(1, 3).end()) == "ay");
+}
+
+#if defined(__unix__)
+OHDEBUG_TEST("Buffer chain, writev")
+{
+	static const char kHeader[] = "HDR";
+	static const char kPayload[] = "payload";
+	Ut::Ct::BufferChain<2> chain;
+	chain.append(Ut::Ct::toBuffer<const void>(kPayload, 7));
+	chain.prepend(Ut::Ct::toBuffer<const void>(kHeader, 3));
+	struct iovec iov[2];
+	int fd[2];
+	assert(pipe(fd) == 0);
+	assert(chain.fillIovec(iov, 1) == 1);
+	assert(chain.fillIovec(iov, 2) == 2);
+	assert(writev(fd[1], iov, 2) == 10);
+	char received[10] = {0};
+	assert(read(fd[0], received, sizeof(received)) == 10);
+	assert(memcmp(received, "HDRpayload", 10) == 0);
+	close(fd[0]);
+	close(fd[1]);
+}
+#endif
+
+OHDEBUG_TEST("Buffer pool, handles and exhaustion")
+{
+	static Ut::Ct::BufferPool<64, 4> pool;
+	{
+		std::vector<Ut::Ct::BufferPool<64, 4>::Handle> handles;
+
+		for (int i = 0; i < 4; ++i) {
+			handles.push_back(pool.tryAllocate());
+			assert(handles.back().valid());
+			Ut::Ct::MemoryBuffer buffer = handles.back();
+			assert(buffer.size() == 64);
+			memset(buffer.data(), i, buffer.size());
+		}
+
+		assert(!pool.tryAllocate().valid());
+		assert(pool.statistics().nExhausted == 1);
+		assert(pool.statistics().nInUse == 4);
+
+		for (int i = 0; i < 4; ++i) {
+			assert(static_cast<std::uint8_t *>(handles[i].buffer().data())[63] == i);  // Blocks do not overlap
+		}
+
+		auto moved = std::move(handles[0]);
+		assert(!handles[0].valid() && moved.valid());
+		moved.reset();
+		assert(pool.statistics().nInUse == 3);
+		assert(pool.tryAllocate().valid());  // Returned on destruction right away
+	}
+	const auto statistics = pool.statistics();
+	assert(statistics.nInUse == 0 && statistics.peakInUse == 4);
+}
+
+template <class PoolType>
+static void drainBufferPool(PoolType &aPool, std::size_t aNblocks)
+{
+	std::vector<typename PoolType::Handle> handles;
+	handles.reserve(aNblocks);
+
+	for (std::size_t i = 0; i < aNblocks; ++i) {
+		handles.push_back(aPool.tryAllocate());
+		assert(handles.back().valid());
+	}
+
+	assert(!aPool.tryAllocate().valid());
+	handles.clear();
+	assert(aPool.statistics().nInUse == 0);
+	assert(aPool.tryAllocate().valid());
+}
+
+OHDEBUG_TEST("Buffer pool, head width")
+{
+	static Ut::Ct::BufferPool<1, 0xFFFE> narrowPool;  // The largest one with a 32-bit head
+	drainBufferPool(narrowPool, 0xFFFE);
+	static Ut::Ct::BufferPool<1, 0x10000> widePool;
+	drainBufferPool(widePool, 0x10000);
+}
+
+OHDEBUG_TEST("Buffer pool, local cache")
+{
+	static Ut::Ct::BufferPool<16, 8> pool;
+	{
+		Ut::Ct::BufferPool<16, 8>::LocalCache<4> cache{pool};
+		auto handle = cache.tryAllocate();
+		assert(handle.valid());
+		assert(cache.count() == 1);  // Refilled with 2 blocks
+		assert(pool.statistics().nInUse == 2);
+		cache.recycle(std::move(handle));
+		assert(!handle.valid() && cache.count() == 2);
+
+		std::vector<Ut::Ct::BufferPool<16, 8>::Handle> handles;
+
+		while (true) {
+			handles.push_back(cache.tryAllocate());
+
+			if (!handles.back().valid()) {
+				handles.pop_back();
+				break;
+			}
+		}
+
+		assert(handles.size() == 8);
+		assert(pool.statistics().nExhausted == 1);
+
+		for (auto &held : handles) {
+			cache.recycle(std::move(held));
+			assert(cache.count() <= 4);
+		}
+
+		assert(pool.statistics().nInUse == cache.count());
+	}
+	assert(pool.statistics().nInUse == 0);  // The cache returns its blocks on destruction
+}
+
+OHDEBUG_TEST("Buffer pool, concurrent allocation")
+{
+	constexpr std::size_t kNthreads = 4;
+	constexpr std::size_t kNiterations = 1 << 14;
+	static Ut::Ct::BufferPool<32, 8> pool;
+	std::vector<std::thread> threads;
+
+	for (std::size_t iThread = 0; iThread < kNthreads; ++iThread) {
+		threads.emplace_back(
+			[iThread]()
+			{
+				Ut::Ct::BufferPool<32, 8>::Handle handles[3];
+
+				for (std::size_t i = 0; i < kNiterations; ++i) {
+					auto &handle = handles[i % 3];
+					handle = pool.tryAllocate();
+
+					if (!handle.valid()) {
+						std::this_thread::yield();
+						continue;
+					}
+
+					const auto buffer = handle.buffer();
+					memset(buffer.data(), static_cast<int>(iThread), buffer.size());
+					std::this_thread::yield();
+
+					for (std::size_t j = 0; j < buffer.size(); ++j) {
+						assert(static_cast<std::uint8_t *>(buffer.data())[j] == iThread);  // Nobody else owns it
+					}
+				}
+			});
+	}
+
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	const auto statistics = pool.statistics();
+	OHDEBUG("Trace", "exhausted", statistics.nExhausted, "peak", statistics.peakInUse);
+	assert(statistics.nInUse == 0 && statistics.peakInUse <= 8);
+}
+
+OHDEBUG_TEST("Buffer reader and writer, endianness")
+{
+	static_assert(Ut::Ct::Layout<std::uint8_t, std::uint16_t, float, std::int64_t>::kSize == 15, "");
+	std::uint8_t storage[32] = {0};
+	Ut::Ct::BufferWriter writer{Ut::Ct::toBuffer<void>(storage, sizeof(storage))};
+	assert(writer.write(std::uint8_t{0xA5}));
+	assert(writer.write<Ut::Ct::Endianness::Big>(std::uint16_t{0x1234}));
+	assert(writer.write(std::uint32_t{0x89ABCDEF}));
+	assert((writer.writeFields<Ut::Ct::Endianness::Big>(std::int16_t{-2}, 1.5f, -0.25)));
+	assert(writer.offset() == 21);
+	const std::uint8_t kExpected[] = {0xA5, 0x12, 0x34, 0xEF, 0xCD, 0xAB, 0x89, 0xFF, 0xFE, 0x3F, 0xC0, 0x00, 0x00,
+		0xBF, 0xD0, 0, 0, 0, 0, 0, 0};
+	assert(memcmp(storage, kExpected, sizeof(kExpected)) == 0);
+
+	// Starting at an odd offset, so every multibyte field is unaligned
+	Ut::Ct::BufferReader reader{writer.written()};
+	std::uint8_t sync = 0;
+	std::uint16_t length = 0;
+	std::uint32_t word = 0;
+	std::int16_t negative = 0;
+	float single = 0;
+	double twice = 0;
+	assert(reader.read(sync) && sync == 0xA5);
+	assert((reader.readFields<Ut::Ct::Endianness::Big>(length)) && length == 0x1234);
+	assert(reader.read(word) && word == 0x89ABCDEF);
+	assert((reader.readFields<Ut::Ct::Endianness::Big>(negative, single, twice)));
+	assert(negative == -2 && single == 1.5f && twice == -0.25);
+	assert(reader.remaining() == 0 && reader.ok());
+}
+
+OHDEBUG_TEST("Buffer reader and writer, bounds and varints")
+{
+	std::uint8_t storage[16] = {0};
+	Ut::Ct::BufferWriter writer{Ut::Ct::toBuffer<void>(storage, sizeof(storage))};
+	assert(writer.writeVarint(0));
+	assert(writer.writeVarint(300));
+	assert(writer.writeZigzagVarint(-1));
+	assert(writer.writeVarint(std::numeric_limits<std::uint64_t>::max()));
+	assert(writer.offset() == 1 + 2 + 1 + 10);
+	assert(!writer.write(std::uint32_t{0}));  // Does not fit, nothing is written
+	assert(writer.offset() == 14 && !writer.ok());
+	assert(!writer.write(std::uint8_t{0}));  // The failure is sticky
+
+	Ut::Ct::BufferReader reader{writer.written()};
+	std::uint64_t value = 1;
+	std::int64_t signedValue = 0;
+	assert(reader.readVarint(value) && value == 0);
+	assert(reader.readVarint(value) && value == 300);
+	assert(reader.readZigzagVarint(signedValue) && signedValue == -1);
+	assert(reader.readVarint(value) && value == std::numeric_limits<std::uint64_t>::max());
+	assert(!reader.readVarint(value) && !reader.ok());
+
+	const std::uint8_t kPayload[] = {1, 2, 3, 4, 5};
+	Ut::Ct::BufferReader payloadReader{Ut::Ct::toBuffer<const void>(kPayload, sizeof(kPayload))};
+	std::uint32_t word = 0;
+	std::uint16_t half = 0;
+	assert(!(payloadReader.readFields(word, half)));  // 6 bytes are checked at once
+	assert(payloadReader.offset() == 0);
+
+	Ut::Ct::BufferReader viewReader{Ut::Ct::toBuffer<const void>(kPayload, sizeof(kPayload))};
+	assert(viewReader.skip(1));
+	const auto view = viewReader.view(3);
+	assert(view.data() == kPayload + 1 && view.size() == 3);
+	assert(viewReader.view(2).data() == nullptr);
+	const std::uint8_t kTruncatedVarint[] = {0x80, 0x80};
+	Ut::Ct::BufferReader truncatedReader{Ut::Ct::toBuffer<const void>(kTruncatedVarint, 2)};
+	assert(!truncatedReader.readVarint(value));
+	const std::uint8_t kOverflowingVarint[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02};
+	Ut::Ct::BufferReader overflowingReader{Ut::Ct::toBuffer<const void>(kOverflowingVarint, sizeof(kOverflowingVarint))};
+	assert(!overflowingReader.readVarint(value) && !overflowingReader.ok());  // Bit 64 is set
+}
+
+OHDEBUG_TEST("Strided buffer, interleaved channels")
+{
+	std::vector<float> samples;
+
+	for (int i = 0; i < 10; ++i) {
+		samples.insert(samples.end(), {static_cast<float>(i), static_cast<float>(10 * i), static_cast<float>(100 * i)});
+	}
+
+	const auto y = Ut::Ct::toStridedBuffer<const float>(Ut::Ct::toBuffer<const void>(samples), 1, 3);
+	assert(y.size() == 10 && y.stride() == 3 && !y.isContiguous());
+	assert(y[0] == 0.0f && y[9] == 90.0f);
+	assert(std::accumulate(y.begin(), y.end(), 0.0f) == 450.0f);
+	assert(y.end() - y.begin() == 10);
+	assert(y.asSlice(2, 5).size() == 3 && y.asSlice(2, 5)[0] == 20.0f);
+	assert(y.asStepped(4).size() == 3 && y.asStepped(4)[2] == 80.0f);
+
+	// The last sample is incomplete
+	const auto z = Ut::Ct::toStridedBuffer<const float>(Ut::Ct::toBuffer<const float>(samples.data(), 29), 2, 3);
+	assert(z.size() == 9 && z[8] == 800.0f);
+	assert(*(z.end() - 1) == 800.0f && z.end()[-9] == 0.0f);  // The end does not point past the samples
+	assert(*std::max_element(z.begin(), z.end()) == 800.0f);
+
+	// Writing through a view
+	auto x = Ut::Ct::toStridedBuffer<float>(Ut::Ct::toBuffer<float>(samples), 0, 3);
+
+	for (float &value : x) {
+		value = -value;
+	}
+
+	assert(samples[3] == -1.0f && samples[4] == 10.0f);
+
+	// Unit stride known at compile time iterates with plain pointers
+	Ut::Ct::StridedBuffer<float, 1> dense{Ut::Ct::toBuffer<float>(samples)};
+	static_assert(std::is_same<decltype(dense.begin()), float *>::value, "");
+	assert(dense.isContiguous() && dense.asBuffer().size() == samples.size());
+	const Ut::Ct::StridedBuffer<float> erased = dense;
+	assert(erased.stride() == 1 && erased[3] == -1.0f);
+}
+
+OHDEBUG_TEST("Buffer 2D, padded rows")
+{
+	constexpr std::size_t kNrows = 4;
+	constexpr std::size_t kNcolumns = 5;
+	constexpr std::size_t kPitch = 8;
+	std::vector<std::uint16_t> frame(kNrows * kPitch, 0xFFFF);
+
+	for (std::size_t row = 0; row < kNrows; ++row) {
+		for (std::size_t column = 0; column < kNcolumns; ++column) {
+			frame[row * kPitch + column] = static_cast<std::uint16_t>(10 * row + column);
+		}
+	}
+
+	// The last row lacks the padding
+	const auto image = Ut::Ct::toBuffer2D<const std::uint16_t>(
+		Ut::Ct::toBuffer<const void>(frame.data(), (kNrows - 1) * kPitch + kNcolumns), kNcolumns, kPitch);
+	assert(image.rows() == kNrows && image.columns() == kNcolumns && image.size() == kNrows * kNcolumns);
+	assert(!image.isContiguous());
+	assert(image(2, 3) == 23);
+	assert(image.row(3).size() == kNcolumns && image.row(3).data()[4] == 34);
+	assert(std::accumulate(image.row(1).begin(), image.row(1).end(), 0) == 60);
+	assert(std::accumulate(image.column(2).begin(), image.column(2).end(), 0) == 68);
+
+	const auto region = image.asSlice(1, 3, 2, 4);
+	assert(region.rows() == 2 && region.columns() == 2 && region.stride() == kPitch);
+	assert(region(0, 0) == 12 && region(1, 1) == 23);
+	assert(image.asSlice(2, 3).isContiguous() && image.asSlice(2, 3).asBuffer().data()[0] == 20);
+
+	const Ut::Ct::Buffer2D<const std::uint16_t> dense{frame.data(), 2, kPitch};
+	assert(dense.isContiguous() && dense.asBuffer().size() == 2 * kPitch);
+}
+
+#if defined(__unix__)
+OHDEBUG_TEST("Mapped buffer, whole file and windows")
+{
+	char path[] = "/tmp/buffer_lib_test_XXXXXX";
+	const int fd = mkstemp(path);
+	assert(fd >= 0);
+	const std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+	const auto content = makeRandomBytes(3 * pageSize + 123, 5);
+	assert(write(fd, content.data(), content.size()) == static_cast<ssize_t>(content.size()));
+	close(fd);
+	{
+		Ut::Ct::MappedBuffer mapped{path};
+		assert(mapped.valid());
+		assert(mapped.fileSize() == content.size());
+		assert(mapped.buffer().size() == content.size());
+		assert(Ut::Al::equal(mapped.buffer(), Ut::Ct::toBuffer<const void>(content)));
+		assert(Ut::Al::equal(mapped.buffer().asSlice(100, 200),
+			Ut::Ct::toBuffer<const void>(content.data() + 100, 100)));
+		assert(mapped.advise(Ut::Ct::MappedBufferAdvice::Sequential));
+		assert(mapped.advise(Ut::Ct::MappedBufferAdvice::WillNeed));
+		assert(mapped.mutableBuffer().data() == nullptr);
+	}
+	{
+		// Windows at offsets, which are not multiples of the page size
+		Ut::Ct::MappedBuffer mapped{path, Ut::Ct::MappedBufferAccess::ReadOnly, pageSize};
+		assert(mapped.buffer().size() == pageSize);
+
+		for (std::size_t offset = 0; offset <= content.size(); offset += pageSize / 3) {
+			assert(mapped.mapWindow(offset));
+			const std::size_t expectedSize = std::min(pageSize, content.size() - offset);
+			assert(mapped.windowOffset() == offset && mapped.buffer().size() == expectedSize);
+			assert(Ut::Al::equal(mapped.buffer(), Ut::Ct::toBuffer<const void>(content.data() + offset, expectedSize)));
+		}
+
+		assert(mapped.mapWindow(content.size()) && mapped.valid());  // An empty window at the end
+		assert(!mapped.mapWindow(content.size() + 1));
+		assert(mapped.valid());  // The window is left as it was
+	}
+	{
+		Ut::Ct::MappedBuffer mapped{path, Ut::Ct::MappedBufferAccess::ReadWrite};
+		Ut::Ct::MappedBuffer moved{std::move(mapped)};
+		assert(!mapped.valid() && mapped.buffer().size() == 0);
+		static_cast<std::uint8_t *>(moved.mutableBuffer().data())[10] = 0x42;
+		assert(moved.sync());
+	}
+	Ut::Ct::MappedBuffer reopened{path};
+	assert(static_cast<const std::uint8_t *>(reopened.buffer().data())[10] == 0x42);
+	unlink(path);
+	assert(!Ut::Ct::MappedBuffer{path}.valid());
+}
+#endif
+
+int main(void)
+{
+	OHDEBUG_RUN_TESTS();
+	return 0;
+}
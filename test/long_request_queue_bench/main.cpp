@@ -0,0 +1,410 @@
+#define OHDEBUG_PORT_ENABLE 1
+#define OHDEBUG_TAGS_ENABLE "Bench"
+
+#include "utility/snippet/LongRequestQueue.hpp"
+#include "utility/snippet/ShardedLongRequestQueue.hpp"
+#include "utility/OhDebug.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using TimeType = std::chrono::milliseconds;
+
+struct Request {
+	std::uint32_t device;
+	std::uint32_t command;
+};
+
+struct CountingRequestHandler : Ut::Sn::RequestHandler<Request> {
+	void retryRequest(const Request &aRequest) override
+	{
+		checksum += aRequest.command;
+		++nRetries;
+	}
+
+	void onRequestExpired(const Request &aRequest) override
+	{
+		checksum += aRequest.device;
+		++nExpired;
+	}
+
+	std::size_t nRetries = 0;
+	std::size_t nExpired = 0;
+	std::size_t checksum = 0;
+};
+
+template <template <class, class, std::size_t> class StorageType>
+using LongRequestQueueType = Ut::Sn::LongRequestQueue<Request, std::mutex, TimeType, 4, StorageType>;
+
+/// `aNrequests` outstanding requests with timeouts of 0.1 .. 10 s, ticked
+/// every millisecond, as a gateway polling a fleet of devices does
+template <template <class, class, std::size_t> class StorageType>
+static void benchTick(const char *aName, std::size_t aNrequests)
+{
+	constexpr std::size_t kNticks = 2000;
+	LongRequestQueueType<StorageType> queue;
+	CountingRequestHandler handler;
+	queue.setRequestHandler(handler);
+	std::mt19937 generator{42};
+	TimeType now{1700000000000};
+	auto start = Clock::now();
+
+	for (std::size_t i = 0; i < aNrequests; ++i) {
+		queue.push({static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(generator())},
+			TimeType{100 + generator() % 9900}, 1 + generator() % 8, now);
+	}
+
+	const double pushSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+	std::int64_t sleepTime = 0;
+	start = Clock::now();
+
+	for (std::size_t i = 0; i < kNticks; ++i) {
+		now += TimeType{1};
+		sleepTime += queue.onTick(now).count();
+	}
+
+	const double tickSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", aName, "requests", aNrequests, "push, ns:", pushSeconds / aNrequests * 1e9, "tick, us:",
+		tickSeconds / kNticks * 1e6, "retries", handler.nRetries, "expired", handler.nExpired, sleepTime,
+		handler.checksum);
+}
+
+OHDEBUG_TEST("Long request queue, tick cost vs number of requests")
+{
+	for (std::size_t nRequests : {10, 100, 1000, 10000, 100000}) {
+		benchTick<Ut::Sn::LongRequestVectorStorage>("vector", nRequests);
+		benchTick<Ut::Sn::LongRequestTimerWheelStorage>("timer wheel", nRequests);
+	}
+}
+
+/// Every request is ACKed. `removeIf` is measured over the first 1000 ACKs
+/// only, as ACKing the whole queue this way is quadratic.
+template <template <class, class, std::size_t> class StorageType>
+static void benchAck(const char *aName, std::size_t aNrequests)
+{
+	LongRequestQueueType<StorageType> queue;
+	std::mt19937 generator{42};
+	std::vector<Ut::Sn::LongRequestHandle> handles;
+	std::vector<std::uint32_t> acks;
+
+	for (std::size_t i = 0; i < aNrequests; ++i) {
+		handles.push_back(queue.push({static_cast<std::uint32_t>(i), 0}, TimeType{100 + generator() % 9900}, 4,
+			TimeType{0}));
+		acks.push_back(static_cast<std::uint32_t>(i));
+	}
+
+	std::shuffle(acks.begin(), acks.end(), generator);
+	const std::size_t nRemoveIf = std::min<std::size_t>(aNrequests / 2, 1000);
+	auto start = Clock::now();
+
+	for (std::size_t i = 0; i < nRemoveIf; ++i) {
+		const std::uint32_t device = acks[i];
+		queue.removeIf([device](Request &aRequest) { return aRequest.device == device; });
+	}
+
+	const double removeIfSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+	start = Clock::now();
+
+	for (std::size_t i = nRemoveIf; i < aNrequests; ++i) {
+		queue.cancel(handles[acks[i]]);
+	}
+
+	const double cancelSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", aName, "requests", aNrequests, "ACK by removeIf, ns:", removeIfSeconds / nRemoveIf * 1e9,
+		"ACK by cancel, ns:", cancelSeconds / (aNrequests - nRemoveIf) * 1e9, queue.size());
+}
+
+OHDEBUG_TEST("Long request queue, ACK processing")
+{
+	for (std::size_t nRequests : {10, 100, 1000, 10000, 100000}) {
+		benchAck<Ut::Sn::LongRequestVectorStorage>("vector", nRequests);
+		benchAck<Ut::Sn::LongRequestTimerWheelStorage>("timer wheel", nRequests);
+	}
+}
+
+/// Writes into a slow port, e.g. a UART: every retry blocks for a while
+struct BlockingRequestHandler : Ut::Sn::RequestHandler<Request> {
+	void retryRequest(const Request &) override
+	{
+		std::this_thread::sleep_for(std::chrono::microseconds{50});
+		++nRetries;
+	}
+
+	std::atomic<std::size_t> nRetries{0};
+};
+
+/// A ticking thread dispatches retries through a blocking handler, while
+/// another thread pushes requests and ACKs them
+template <Ut::Sn::LongRequestDispatch kDispatch>
+static void benchPushLatency(const char *aName)
+{
+	using QueueType = Ut::Sn::LongRequestQueue<Request, std::mutex, TimeType, 4,
+		Ut::Sn::LongRequestTimerWheelStorage, kDispatch>;
+	constexpr std::size_t kNrequests = 200;
+	constexpr std::size_t kNpushes = 1000;
+	QueueType queue;
+	BlockingRequestHandler handler;
+	std::mt19937 generator{42};
+
+	for (std::size_t i = 0; i < kNrequests; ++i) {
+		queue.push({static_cast<std::uint32_t>(i), 0}, TimeType{20 + generator() % 80}, 1000000, TimeType{0});
+	}
+
+	queue.setRequestHandler(handler);
+	const auto origin = Clock::now();
+	std::atomic<bool> done{false};
+	std::thread ticker{
+		[&]()
+		{
+			while (!done.load()) {
+				queue.onTick(std::chrono::duration_cast<TimeType>(Clock::now() - origin));
+				std::this_thread::sleep_for(std::chrono::milliseconds{1});
+			}
+		}};
+	double maxLatency = 0;
+	double sumLatency = 0;
+
+	for (std::size_t i = 0; i < kNpushes; ++i) {
+		const auto now = std::chrono::duration_cast<TimeType>(Clock::now() - origin);
+		const auto start = Clock::now();
+		const auto handle = queue.push({0, 0}, TimeType{1000}, 1, now);
+		queue.cancel(handle);
+		const double latency = std::chrono::duration<double>(Clock::now() - start).count();
+		maxLatency = std::max(maxLatency, latency);
+		sumLatency += latency;
+		std::this_thread::sleep_for(std::chrono::microseconds{200});
+	}
+
+	done.store(true);
+	ticker.join();
+	OHDEBUG("Bench", aName, "push + cancel latency, mean us:", sumLatency / kNpushes * 1e6, "max us:",
+		maxLatency * 1e6, "retries dispatched", handler.nRetries.load());
+}
+
+OHDEBUG_TEST("Long request queue, push latency under a blocking handler")
+{
+	benchPushLatency<Ut::Sn::LongRequestDispatch::UnderLock>("under lock");
+	benchPushLatency<Ut::Sn::LongRequestDispatch::OutsideLock>("outside lock");
+}
+
+/// Steady load of `aNrequests` requests, each one ACKed and replaced with a
+/// new one, as the replies arrive. Worst cases are what a real-time loop is
+/// sized for, so the maximums are reported along with the means.
+template <template <class, class, std::size_t> class StorageType, std::size_t kInitialSize>
+static void benchWorstCase(const char *aName, std::size_t aNrequests)
+{
+	using QueueType = Ut::Sn::LongRequestQueue<Request, std::mutex, TimeType, kInitialSize, StorageType>;
+	constexpr std::size_t kNticks = 2000;
+	std::unique_ptr<QueueType> queuePointer{new QueueType{}};  // Fixed storage is too large for the stack
+	QueueType &queue = *queuePointer;
+	CountingRequestHandler handler;
+	queue.setRequestHandler(handler);
+	std::mt19937 generator{42};
+	std::vector<Ut::Sn::LongRequestHandle> handles;
+	TimeType now{0};
+	double maxPush = 0;
+	double sumPush = 0;
+	double maxTick = 0;
+	double sumTick = 0;
+	std::size_t nPushes = 0;
+
+	for (std::size_t iTick = 0; iTick < kNticks; ++iTick) {
+		now += TimeType{1};
+
+		while (handles.size() < aNrequests) {
+			const auto start = Clock::now();
+			handles.push_back(queue.push({static_cast<std::uint32_t>(nPushes), 0}, TimeType{100 + generator() % 900},
+				4, now));
+			const double latency = std::chrono::duration<double>(Clock::now() - start).count();
+			maxPush = std::max(maxPush, latency);
+			sumPush += latency;
+			++nPushes;
+		}
+
+		for (std::size_t iAck = 0; iAck < aNrequests / 100 + 1; ++iAck) {
+			const std::size_t position = generator() % handles.size();
+			queue.cancel(handles[position]);
+			handles[position] = handles.back();
+			handles.pop_back();
+		}
+
+		const auto start = Clock::now();
+		queue.onTick(now);
+		const double latency = std::chrono::duration<double>(Clock::now() - start).count();
+		maxTick = std::max(maxTick, latency);
+		sumTick += latency;
+	}
+
+	OHDEBUG("Bench", aName, "requests", aNrequests, "push, mean ns:", sumPush / nPushes * 1e9, "max ns:",
+		maxPush * 1e9, "tick, mean us:", sumTick / kNticks * 1e6, "max us:", maxTick * 1e6, "overflows",
+		queue.overflowCount(), handler.checksum);
+}
+
+OHDEBUG_TEST("Long request queue, worst case latency")
+{
+	benchWorstCase<Ut::Sn::LongRequestVectorStorage, 4>("vector", 1000);
+	benchWorstCase<Ut::Sn::LongRequestTimerWheelStorage, 4>("timer wheel", 1000);
+	benchWorstCase<Ut::Sn::LongRequestFixedStorage<1024>::Storage, 1024>("fixed", 1000);
+	benchWorstCase<Ut::Sn::LongRequestVectorStorage, 4>("vector", 10000);
+	benchWorstCase<Ut::Sn::LongRequestTimerWheelStorage, 4>("timer wheel", 10000);
+	benchWorstCase<Ut::Sn::LongRequestFixedStorage<16384>::Storage, 16384>("fixed", 10000);
+}
+
+/// One link's handler. Every retry costs some CPU time, e.g. for framing and
+/// checksumming a packet. Lateness is how much later than due a request has
+/// been retried, the due moment is 1 ms past the timeout.
+struct LinkRequestHandler : Ut::Sn::RequestHandler<Request> {
+	void retryRequest(const Request &aRequest) override
+	{
+		std::uint32_t hash = aRequest.command;
+
+		for (unsigned i = 0; i < 2000; ++i) {
+			hash = hash * 1664525u + 1013904223u;
+		}
+
+		checksum += hash;
+		const auto now = Clock::now();
+
+		if (lastRetries[aRequest.device] != Clock::time_point{}) {
+			const double lateness = std::chrono::duration<double>(now - lastRetries[aRequest.device]
+				- TimeType{aRequest.command + 1}).count();
+			maxLateness = std::max(maxLateness, lateness);
+			sumLateness += lateness;
+			++nRetries;
+		}
+
+		lastRetries[aRequest.device] = now;
+	}
+
+	std::vector<Clock::time_point> lastRetries;
+	std::size_t nRetries = 0;
+	double sumLateness = 0;
+	double maxLateness = 0;
+	std::uint32_t checksum = 0;
+};
+
+static constexpr std::size_t kNlinks = 256;
+static constexpr std::size_t kNlinkRequests = 16;
+static constexpr std::chrono::milliseconds kShardsBenchDuration{1000};
+
+static std::vector<LinkRequestHandler> makeLinkHandlers()
+{
+	std::vector<LinkRequestHandler> handlers(kNlinks);
+
+	for (LinkRequestHandler &handler : handlers) {
+		handler.lastRetries.resize(kNlinkRequests);
+	}
+
+	return handlers;
+}
+
+/// `kNlinkRequests` requests per link, timeouts of 5 .. 50 ms
+template <class PushType>
+static void pushLinkRequests(PushType &&aPush)
+{
+	std::mt19937 generator{42};
+
+	for (std::size_t link = 0; link < kNlinks; ++link) {
+		for (std::size_t i = 0; i < kNlinkRequests; ++i) {
+			aPush(link, Request{static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(5 + generator() % 45)});
+		}
+	}
+}
+
+static void reportShards(const char *aName, std::size_t aNworkers, const std::vector<LinkRequestHandler> &aHandlers,
+	std::clock_t aCpuStart)
+{
+	const double cpuSeconds = static_cast<double>(std::clock() - aCpuStart) / CLOCKS_PER_SEC;
+	std::size_t nRetries = 0;
+	double sumLateness = 0;
+	double maxLateness = 0;
+	std::uint32_t checksum = 0;
+
+	for (const LinkRequestHandler &handler : aHandlers) {
+		nRetries += handler.nRetries;
+		sumLateness += handler.sumLateness;
+		maxLateness = std::max(maxLateness, handler.maxLateness);
+		checksum += handler.checksum;
+	}
+
+	OHDEBUG("Bench", aName, "workers", aNworkers, "retries per s:", nRetries / std::chrono::duration<double>(
+		kShardsBenchDuration).count(), "lateness, mean us:", sumLateness / nRetries * 1e6, "max us:",
+		maxLateness * 1e6, "CPU, s:", cpuSeconds, checksum);
+}
+
+/// One thread ticking every link's queue in sequence at a fixed rate
+static void benchFixedRateTicker()
+{
+	using QueueType = LongRequestQueueType<Ut::Sn::LongRequestTimerWheelStorage>;
+	std::vector<QueueType> queues(kNlinks);
+	const auto origin = Clock::now();
+	auto now = [origin]() { return std::chrono::duration_cast<TimeType>(Clock::now() - origin); };
+	std::vector<LinkRequestHandler> handlers = makeLinkHandlers();
+
+	for (std::size_t link = 0; link < kNlinks; ++link) {
+		queues[link].setRequestHandler(handlers[link]);
+	}
+
+	pushLinkRequests([&](std::size_t aLink, const Request &aRequest)
+		{
+			queues[aLink].push(aRequest, TimeType{aRequest.command}, 1000000, now());
+		});
+	const std::clock_t cpuStart = std::clock();
+	const auto end = Clock::now() + kShardsBenchDuration;
+
+	while (Clock::now() < end) {
+		for (QueueType &queue : queues) {
+			queue.onTick(now());
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds{1});
+	}
+
+	reportShards("fixed rate ticker", 1, handlers, cpuStart);
+}
+
+static void benchShards(std::size_t aNworkers)
+{
+	Ut::Sn::ShardedLongRequestQueue<Request, TimeType, 4, Ut::Sn::LongRequestTimerWheelStorage> queue{kNlinks,
+		aNworkers};
+	std::vector<LinkRequestHandler> handlers = makeLinkHandlers();
+
+	for (std::size_t link = 0; link < kNlinks; ++link) {
+		queue.setRequestHandler(link, handlers[link]);
+	}
+
+	pushLinkRequests([&queue](std::size_t aLink, const Request &aRequest)
+		{
+			queue.push(aLink, aRequest, TimeType{aRequest.command}, 1000000);
+		});
+	const std::clock_t cpuStart = std::clock();
+	queue.start();
+	std::this_thread::sleep_for(kShardsBenchDuration);
+	queue.stop();
+	reportShards("sharded", aNworkers, handlers, cpuStart);
+}
+
+OHDEBUG_TEST("Long request queue, sharding across cores")
+{
+	const std::size_t nCores = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	OHDEBUG("Bench", "links", kNlinks, "requests per link", kNlinkRequests, "cores", nCores);
+	benchFixedRateTicker();
+
+	for (std::size_t nWorkers = 1; nWorkers <= 2 * nCores && nWorkers <= 16; nWorkers *= 2) {
+		benchShards(nWorkers);
+	}
+}
+
+int main(void)
+{
+	OHDEBUG_RUN_TESTS();
+	return 0;
+}
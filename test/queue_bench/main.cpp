@@ -0,0 +1,463 @@
+#define OHDEBUG_PORT_ENABLE 1
+#define OHDEBUG_TAGS_ENABLE "Bench"
+
+#include "utility/container/FixedSizePriorityQueue.hpp"
+#include "utility/container/FixedSizeQueue.hpp"
+#include "utility/container/MpmcFixedSizeQueue.hpp"
+#include "utility/container/RecordRing.hpp"
+#include "utility/snippet/LockWrapper.hpp"
+#include "utility/OhDebug.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kQueueSize = 1024;
+constexpr std::size_t kNitems = 1 << 22;
+constexpr std::size_t kNroundTrips = 1 << 16;
+constexpr std::size_t kPriorityQueueSize = 1024;
+
+/// Adapters providing the same push / pop interface for every queue under test
+
+template <class QueueType>
+struct Direct {
+	QueueType queue;
+
+	template <class T>
+	bool tryPush(const T &aValue)
+	{
+		return queue.tryPush(aValue);
+	}
+
+	template <class T>
+	bool tryPop(T &aValue)
+	{
+		return queue.tryPop(aValue);
+	}
+};
+
+template <class QueueType>
+struct Locked {
+	Ut::Sn::LockWrapper<QueueType, std::mutex> queue;
+
+	template <class T>
+	bool tryPush(const T &aValue)
+	{
+		return queue.makeLock()->tryPush(aValue);
+	}
+
+	template <class T>
+	bool tryPop(T &aValue)
+	{
+		return queue.makeLock()->tryPop(aValue);
+	}
+};
+
+template <class Q, class T>
+static void spinPush(Q &aQueue, const T &aValue)
+{
+	while (!aQueue.tryPush(aValue)) {
+		std::this_thread::yield();
+	}
+}
+
+template <class Q, class T>
+static void spinPop(Q &aQueue, T &aValue)
+{
+	while (!aQueue.tryPop(aValue)) {
+		std::this_thread::yield();
+	}
+}
+
+/// Producer thread pushes `kNitems`, the current thread pops them
+template <class Q>
+static void benchThroughput(const char *aName)
+{
+	Q queue{};
+	const auto start = Clock::now();
+	std::thread producer{
+		[&queue]()
+		{
+			for (std::size_t i = 0; i < kNitems; ++i) {
+				spinPush(queue, i);
+			}
+		}};
+
+	for (std::size_t i = 0; i < kNitems; ++i) {
+		std::size_t value = 0;
+		spinPop(queue, value);
+		assert(value == i);
+	}
+
+	producer.join();
+	const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", aName, "throughput, Mitems/s:", static_cast<double>(kNitems) / seconds / 1e6);
+}
+
+/// Ping-pong over two queues, reports median and 99th percentile round trip
+template <class Q>
+static void benchLatency(const char *aName)
+{
+	Q ping{};
+	Q pong{};
+	std::vector<double> roundTrips;
+	roundTrips.reserve(kNroundTrips);
+	std::thread echo{
+		[&ping, &pong]()
+		{
+			for (std::size_t i = 0; i < kNroundTrips; ++i) {
+				std::size_t value = 0;
+				spinPop(ping, value);
+				spinPush(pong, value);
+			}
+		}};
+
+	for (std::size_t i = 0; i < kNroundTrips; ++i) {
+		std::size_t value = 0;
+		const auto start = Clock::now();
+		spinPush(ping, i);
+		spinPop(pong, value);
+		roundTrips.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+		assert(value == i);
+	}
+
+	echo.join();
+	std::sort(roundTrips.begin(), roundTrips.end());
+	OHDEBUG("Bench", aName, "round trip, ns: median", roundTrips[roundTrips.size() / 2], "p99",
+		roundTrips[roundTrips.size() * 99 / 100]);
+}
+
+/// `aNthreads` producers and `aNthreads` consumers share the queue
+template <class Q>
+static void benchScaling(const char *aName, std::size_t aNthreads)
+{
+	Q queue{};
+	const std::size_t nItemsPerThread = kNitems / aNthreads;
+	std::atomic<std::size_t> nPopped{0};
+	std::vector<std::thread> threads;
+	const auto start = Clock::now();
+
+	for (std::size_t iThread = 0; iThread < aNthreads; ++iThread) {
+		threads.emplace_back(
+			[&queue, nItemsPerThread]()
+			{
+				for (std::size_t i = 0; i < nItemsPerThread; ++i) {
+					spinPush(queue, i);
+				}
+			});
+		threads.emplace_back(
+			[&queue, &nPopped, nItemsPerThread, aNthreads]()
+			{
+				std::size_t value = 0;
+
+				while (nPopped.load(std::memory_order_relaxed) < nItemsPerThread * aNthreads) {
+					if (queue.tryPop(value)) {
+						nPopped.fetch_add(1, std::memory_order_relaxed);
+					} else {
+						std::this_thread::yield();
+					}
+				}
+			});
+	}
+
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", aName, "producers = consumers =", aNthreads, "throughput, Mitems/s:",
+		static_cast<double>(nItemsPerThread * aNthreads) / seconds / 1e6);
+}
+
+OHDEBUG_TEST("SPSC throughput")
+{
+	benchThroughput<Locked<Ut::Ct::FixedSizeQueue<std::size_t, kQueueSize>>>("FixedSizeQueue + std::mutex");
+	benchThroughput<Direct<Ut::Ct::SpscFixedSizeQueue<std::size_t, kQueueSize>>>("SpscFixedSizeQueue");
+}
+
+OHDEBUG_TEST("SPSC latency")
+{
+	benchLatency<Locked<Ut::Ct::FixedSizeQueue<std::size_t, kQueueSize>>>("FixedSizeQueue + std::mutex");
+	benchLatency<Direct<Ut::Ct::SpscFixedSizeQueue<std::size_t, kQueueSize>>>("SpscFixedSizeQueue");
+}
+
+OHDEBUG_TEST("MPMC scaling")
+{
+	const std::size_t maxThreads = std::max<std::size_t>(2, std::thread::hardware_concurrency());
+
+	for (std::size_t nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+		benchScaling<Locked<Ut::Ct::FixedSizeQueue<std::size_t, kQueueSize>>>("FixedSizeQueue + std::mutex",
+			nThreads);
+		benchScaling<Direct<Ut::Ct::MpmcFixedSizeQueue<std::size_t, kQueueSize>>>("MpmcFixedSizeQueue", nThreads);
+	}
+}
+
+OHDEBUG_TEST("Byte stream, per-element vs bulk")
+{
+	constexpr std::size_t kNbytes = 1 << 26;
+	constexpr std::size_t kChunkSize = 64;
+	std::vector<std::uint8_t> input(kChunkSize, 0x55);
+	std::vector<std::uint8_t> output(kChunkSize);
+	Ut::Ct::FixedSizeQueue<std::uint8_t, kQueueSize> queue;
+	std::size_t checksum = 0;
+
+	auto start = Clock::now();
+
+	for (std::size_t i = 0; i < kNbytes; i += kChunkSize) {
+		for (std::size_t j = 0; j < kChunkSize; ++j) {
+			queue.tryPush(input[j]);
+		}
+
+		for (std::size_t j = 0; j < kChunkSize; ++j) {
+			queue.tryPop(output[j]);
+		}
+
+		checksum += output[i % kChunkSize];
+	}
+
+	double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", "tryPush / tryPop, MB/s:", static_cast<double>(kNbytes) / seconds / 1e6, checksum);
+	start = Clock::now();
+
+	for (std::size_t i = 0; i < kNbytes; i += kChunkSize) {
+		queue.tryPushN(input.data(), kChunkSize);
+		queue.tryPopN(output.data(), kChunkSize);
+		checksum += output[i % kChunkSize];
+	}
+
+	seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", "tryPushN / tryPopN, MB/s:", static_cast<double>(kNbytes) / seconds / 1e6, checksum);
+}
+
+/// Serial protocol frames: mostly short, sometimes up to 2 KiB
+static std::vector<std::size_t> makeFrameSizes(std::size_t aCount)
+{
+	std::mt19937 generator{42};
+	std::uniform_int_distribution<std::size_t> shortFrame{8, 128};
+	std::uniform_int_distribution<std::size_t> longFrame{129, 2048};
+	std::uniform_int_distribution<int> percent{0, 99};
+	std::vector<std::size_t> sizes(aCount);
+
+	for (auto &size : sizes) {
+		size = percent(generator) < 90 ? shortFrame(generator) : longFrame(generator);
+	}
+
+	return sizes;
+}
+
+struct Frame {
+	std::size_t size;
+	std::uint8_t payload[2048];
+};
+
+constexpr std::size_t kNframeSlots = 32;
+constexpr std::size_t kRecordRingSize = 1 << 16;
+
+OHDEBUG_TEST("Variable-length frames, memory use")
+{
+	const auto frameSizes = makeFrameSizes(4096);
+	static std::uint8_t frame[2048];
+	Ut::Ct::SpscFixedSizeQueue<Frame, kNframeSlots> queue;
+	alignas(4) static std::uint8_t arena[kRecordRingSize];
+	Ut::Ct::RecordRing<> ring{Ut::Ct::toBuffer<void>(arena, sizeof(arena))};
+	std::size_t nFrames = 0;
+	std::size_t nRecords = 0;
+
+	while (queue.tryReserve() != nullptr) {
+		queue.commit();
+		++nFrames;
+	}
+
+	while (ring.tryPush(Ut::Ct::toBuffer<const void>(frame, frameSizes[nRecords % frameSizes.size()]))) {
+		++nRecords;
+	}
+
+	OHDEBUG("Bench", "SpscFixedSizeQueue<Frame>: bytes", sizeof(queue), "frames in flight", nFrames);
+	OHDEBUG("Bench", "RecordRing: bytes", sizeof(arena) + sizeof(ring), "frames in flight", nRecords);
+}
+
+OHDEBUG_TEST("Variable-length frames, throughput")
+{
+	constexpr std::size_t kNframes = 1 << 20;
+	const auto frameSizes = makeFrameSizes(4096);
+	std::size_t nBytes = 0;
+
+	for (std::size_t i = 0; i < kNframes; ++i) {
+		nBytes += frameSizes[i % frameSizes.size()];
+	}
+
+	static std::uint8_t frame[2048];
+	auto start = Clock::now();
+	{
+		Ut::Ct::SpscFixedSizeQueue<Frame, kNframeSlots> queue;
+		std::thread producer{
+			[&queue, &frameSizes]()
+			{
+				for (std::size_t i = 0; i < kNframes; ++i) {
+					Frame *slot = queue.tryReserve();
+
+					while (slot == nullptr) {
+						std::this_thread::yield();
+						slot = queue.tryReserve();
+					}
+
+					slot->size = frameSizes[i % frameSizes.size()];
+					memcpy(slot->payload, frame, slot->size);
+					queue.commit();
+				}
+			}};
+
+		for (std::size_t i = 0; i < kNframes; ++i) {
+			Frame *slot = queue.peek();
+
+			while (slot == nullptr) {
+				std::this_thread::yield();
+				slot = queue.peek();
+			}
+
+			assert(slot->size == frameSizes[i % frameSizes.size()]);
+			queue.release();
+		}
+
+		producer.join();
+	}
+	double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", "SpscFixedSizeQueue<Frame>, MB/s:", static_cast<double>(nBytes) / seconds / 1e6);
+
+	start = Clock::now();
+	{
+		alignas(4) static std::uint8_t arena[kRecordRingSize];
+		Ut::Ct::RecordRing<> ring{Ut::Ct::toBuffer<void>(arena, sizeof(arena))};
+		std::thread producer{
+			[&ring, &frameSizes]()
+			{
+				for (std::size_t i = 0; i < kNframes; ++i) {
+					const auto frameBuffer = Ut::Ct::toBuffer<const void>(frame, frameSizes[i % frameSizes.size()]);
+
+					while (!ring.tryPush(frameBuffer)) {
+						std::this_thread::yield();
+					}
+				}
+			}};
+
+		for (std::size_t i = 0; i < kNframes; ++i) {
+			auto record = ring.peek();
+
+			while (record.data() == nullptr) {
+				std::this_thread::yield();
+				record = ring.peek();
+			}
+
+			assert(record.size() == frameSizes[i % frameSizes.size()]);
+			ring.release();
+		}
+
+		producer.join();
+	}
+	seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", "RecordRing, MB/s:", static_cast<double>(nBytes) / seconds / 1e6);
+}
+
+/// Scheduler-like load: the queue is kept about half full, pushes and pops
+/// are interleaved
+template <class PushType, class PopType>
+static void benchPriorityQueue(const char *aName, PushType &&aPush, PopType &&aPop)
+{
+	constexpr std::size_t kNoperations = 1 << 22;
+	std::mt19937 generator{42};
+	std::vector<std::uint32_t> priorities(4096);
+
+	for (auto &priority : priorities) {
+		priority = generator();
+	}
+
+	for (std::size_t i = 0; i < kPriorityQueueSize / 2; ++i) {
+		aPush(priorities[i]);
+	}
+
+	std::uint64_t checksum = 0;
+	const auto start = Clock::now();
+
+	for (std::size_t i = 0; i < kNoperations; ++i) {
+		aPush(priorities[i % priorities.size()]);
+		checksum += aPop();
+	}
+
+	const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", aName, "push + pop, Mops/s:", static_cast<double>(kNoperations) / seconds / 1e6, checksum);
+}
+
+OHDEBUG_TEST("Large frames, tryPop vs tryConsume")
+{
+	constexpr std::size_t kNframes = 1 << 20;
+	static Ut::Ct::FixedSizeQueue<Frame, kNframeSlots> queue;
+	static Frame frame;
+	std::size_t checksum = 0;
+	auto start = Clock::now();
+
+	for (std::size_t i = 0; i < kNframes; ++i) {
+		frame.size = i;
+		queue.tryPush(frame);
+		queue.tryPop(frame);
+		checksum += frame.size + frame.payload[i % sizeof(frame.payload)];
+	}
+
+	double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", "tryPop, Mframes/s:", static_cast<double>(kNframes) / seconds / 1e6, checksum);
+	start = Clock::now();
+
+	for (std::size_t i = 0; i < kNframes; ++i) {
+		frame.size = i;
+		queue.tryPush(frame);
+		queue.tryConsume(
+			[&checksum, i](const Frame &aFrame)
+			{
+				checksum += aFrame.size + aFrame.payload[i % sizeof(aFrame.payload)];
+			});
+	}
+
+	seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	OHDEBUG("Bench", "tryConsume, Mframes/s:", static_cast<double>(kNframes) / seconds / 1e6, checksum);
+}
+
+OHDEBUG_TEST("Priority queue, 4-ary heap vs std::priority_queue")
+{
+	{
+		std::priority_queue<std::uint32_t, std::vector<std::uint32_t>> queue;
+		benchPriorityQueue("std::priority_queue",
+			[&queue](std::uint32_t aPriority) {queue.push(aPriority);},
+			[&queue]()
+			{
+				const std::uint32_t ret = queue.top();
+				queue.pop();
+
+				return ret;
+			});
+	}
+	{
+		static Ut::Ct::FixedSizePriorityQueue<std::uint32_t, kPriorityQueueSize> queue;
+		benchPriorityQueue("FixedSizePriorityQueue",
+			[](std::uint32_t aPriority) {queue.tryPush(aPriority);},
+			[]()
+			{
+				std::uint32_t ret = 0;
+				queue.tryPop(ret);
+
+				return ret;
+			});
+	}
+}
+
+int main(void)
+{
+	OHDEBUG_RUN_TESTS();
+	return 0;
+}
@@ -1,9 +1,28 @@
 #define OHDEBUG_PORT_ENABLE 1
 #define OHDEBUG_TAGS_ENABLE "Trace"
 
+#include "utility/container/BlockingFixedSizeQueue.hpp"
+#include "utility/container/BroadcastRing.hpp"
+#include "utility/container/FixedSizePriorityQueue.hpp"
 #include "utility/container/FixedSizeQueue.hpp"
+#include "utility/container/MirroredRingBuffer.hpp"
+#include "utility/container/MpmcFixedSizeQueue.hpp"
+#include "utility/container/QueueStatistics.hpp"
+#include "utility/container/RecordRing.hpp"
+#include "utility/container/RingBuffer.hpp"
 #include "utility/OhDebug.hpp"
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
 
 constexpr std::size_t queueSize()
 {
@@ -73,6 +92,750 @@ OHDEBUG_TEST("Queue iteration")
 	}
 }
 
+OHDEBUG_TEST("Bulk push, pop with wraparound")
+{
+	Ut::Ct::FixedSizeQueue<std::uint8_t, 8> bytes;
+	Ut::Ct::FixedSizeQueue<std::string, 8> strings;
+	const std::uint8_t input[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	const std::string inputStrings[] = {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"};
+	std::uint8_t output[10] = {0};
+	std::string outputStrings[10];
+
+	// Shift cursors, so the next batch wraps around
+	assert(bytes.tryPushN(input, 5) == 5);
+	assert(bytes.tryPopN(output, 5) == 5);
+	assert(strings.tryPushN(inputStrings, 5) == 5);
+	assert(strings.tryPopN(outputStrings, 5) == 5);
+
+	assert(bytes.tryPushN(input, 10) == 8);
+	assert(bytes.count() == 8);
+	assert(!bytes.tryPush(0));
+	assert(strings.tryPushN(inputStrings, 10) == 8);
+	assert(strings.count() == 8);
+
+	assert(bytes.tryPopN(output, 3) == 3);
+	assert(bytes.tryPopN(output + 3, 10) == 5);
+	assert(bytes.count() == 0);
+	assert(strings.tryPopN(outputStrings, 10) == 8);
+	assert(strings.count() == 0);
+
+	for (int i = 0; i < 8; ++i) {
+		assert(output[i] == input[i]);
+		assert(outputStrings[i] == inputStrings[i]);
+	}
+}
+
+OHDEBUG_TEST("Reserve, commit, peek, release")
+{
+	struct Frame {
+		std::size_t size;
+		std::uint8_t payload[1024];
+	};
+
+	Ut::Ct::FixedSizeQueue<Frame, 2> queue;
+	assert(queue.peek() == nullptr);
+
+	for (std::size_t i = 0; i < 3; ++i) {
+		Frame *frame = queue.tryReserve();
+		assert(frame != nullptr);
+		assert(queue.count() == 0);  // Not published yet
+		frame->size = i;
+		frame->payload[i] = static_cast<std::uint8_t>(i);
+		queue.commit();
+		assert(queue.count() == 1);
+
+		const Frame *consumed = queue.peek();
+		assert(consumed == frame);
+		assert(consumed->size == i);
+		assert(consumed->payload[i] == i);
+		queue.release();
+		assert(queue.count() == 0);
+	}
+
+	assert(queue.tryReserve(Frame{42, {}}) != nullptr);
+	queue.commit();
+	assert(queue.tryReserve() != nullptr);
+	queue.commit();
+	assert(queue.tryReserve() == nullptr);
+	assert(queue.peek()->size == 42);
+}
+
+OHDEBUG_TEST("SPSC queue, producer and consumer threads")
+{
+	constexpr std::size_t kNitems = 1 << 16;
+	Ut::Ct::SpscFixedSizeQueue<std::size_t, 8> queue;
+	std::thread producer{
+		[&queue]()
+		{
+			for (std::size_t i = 0; i < kNitems; ++i) {
+				while (!queue.tryPush(i)) {
+					std::this_thread::yield();
+				}
+			}
+		}};
+
+	for (std::size_t i = 0; i < kNitems; ++i) {
+		std::size_t value = 0;
+
+		while (!queue.tryPop(value)) {
+			std::this_thread::yield();
+		}
+
+		assert(value == i);
+	}
+
+	producer.join();
+	assert(queue.count() == 0);
+}
+
+OHDEBUG_TEST("MPMC queue, multiple producers and consumers")
+{
+	constexpr std::size_t kNthreads = 3;
+	constexpr std::size_t kNitemsPerThread = 1 << 14;
+	Ut::Ct::MpmcFixedSizeQueue<std::size_t, 16> queue;
+	std::atomic<std::size_t> nPopped{0};
+	std::atomic<std::size_t> sumPopped{0};
+	std::vector<std::thread> threads;
+
+	for (std::size_t iThread = 0; iThread < kNthreads; ++iThread) {
+		threads.emplace_back(
+			[&queue]()
+			{
+				for (std::size_t i = 1; i <= kNitemsPerThread; ++i) {
+					while (!queue.tryEmplace(i)) {
+						std::this_thread::yield();
+					}
+				}
+			});
+		threads.emplace_back(
+			[&queue, &nPopped, &sumPopped]()
+			{
+				std::size_t value = 0;
+
+				while (nPopped.load() < kNthreads * kNitemsPerThread) {
+					if (queue.tryPop(value)) {
+						sumPopped += value;
+						++nPopped;
+					} else {
+						std::this_thread::yield();
+					}
+				}
+			});
+	}
+
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	OHDEBUG("Trace", "popped", nPopped.load(), "items");
+	assert(nPopped.load() == kNthreads * kNitemsPerThread);
+	assert(sumPopped.load() == kNthreads * kNitemsPerThread * (kNitemsPerThread + 1) / 2);
+	assert(queue.count() == 0);
+}
+
+OHDEBUG_TEST("Ring buffer over caller-supplied memory")
+{
+	static std::uint32_t arena[12];  // Not a power of 2, only 8 elements will be used
+	Ut::Ct::RingBuffer<std::uint32_t> ring{Ut::Ct::toBuffer<void>(arena, 12)};
+	assert(ring.capacity() == 8);
+
+	for (std::uint32_t i = 0; i < 11; ++i) {
+		ring.forcePush(i);
+	}
+
+	assert(ring.count() == 8);
+	std::uint32_t expected = 3;
+
+	for (const auto &item : ring) {
+		assert(item == expected++);
+	}
+
+	std::uint32_t output[8] = {0};
+	assert(ring.tryPopN(output, 8) == 8);
+	assert(output[0] == 3 && output[7] == 10);
+	assert(ring.count() == 0);
+}
+
+OHDEBUG_TEST("Variable-length record ring")
+{
+	alignas(4) static std::uint8_t arena[64];
+	Ut::Ct::RecordRing<Ut::Ct::PlainQueueCursors> ring{Ut::Ct::toBuffer<void>(arena, sizeof(arena))};
+	const char kRecords[][12] = {"abc", "hello world", "0123456789", "x"};
+	assert(ring.peek().data() == nullptr);
+	assert(!ring.tryPush(Ut::Ct::toBuffer<const void>(arena, ring.maxRecordSize() + 1)));
+
+	// Fill and drain repeatedly, so records get placed over the wraparound point
+	for (std::size_t iRecord = 0; iRecord < 32; ++iRecord) {
+		const char *record = kRecords[iRecord % 4];
+		const auto recordSize = strlen(record);
+
+		while (!ring.tryPush(Ut::Ct::toBuffer<const void>(record, recordSize))) {
+			ring.peek();
+			ring.release();
+		}
+	}
+
+	std::size_t nPopped = 0;
+
+	for (auto record = ring.peek(); record.data() != nullptr; record = ring.peek(), ++nPopped) {
+		bool matches = false;
+
+		for (const auto &expected : kRecords) {
+			matches = matches || (record.size() == strlen(expected) && memcmp(record.data(), expected,
+				record.size()) == 0);
+		}
+
+		assert(matches);
+		ring.release();
+	}
+
+	OHDEBUG("Trace", "popped", nPopped, "records");
+	assert(nPopped > 0);
+	assert(ring.bytesUsed() == 0);
+}
+
+OHDEBUG_TEST("SPSC record ring, producer and consumer threads")
+{
+	constexpr std::size_t kNrecords = 1 << 14;
+	alignas(4) static std::uint8_t arena[256];
+	Ut::Ct::RecordRing<> ring{Ut::Ct::toBuffer<void>(arena, sizeof(arena))};
+	std::thread producer{
+		[&ring]()
+		{
+			for (std::uint32_t i = 0; i < kNrecords; ++i) {
+				Ut::Ct::MemoryBuffer record = ring.tryReserve(i % 64 + sizeof(i));
+
+				while (record.data() == nullptr) {
+					std::this_thread::yield();
+					record = ring.tryReserve(i % 64 + sizeof(i));
+				}
+
+				memset(record.data(), static_cast<int>(i), record.size());
+				memcpy(record.data(), &i, sizeof(i));
+				ring.commit(record.size());
+			}
+		}};
+
+	for (std::uint32_t i = 0; i < kNrecords; ++i) {
+		Ut::Ct::ConstMemoryBuffer record = ring.peek();
+
+		while (record.data() == nullptr) {
+			std::this_thread::yield();
+			record = ring.peek();
+		}
+
+		std::uint32_t value = 0;
+		memcpy(&value, record.data(), sizeof(value));
+		assert(value == i);
+		assert(record.size() == i % 64 + sizeof(i));
+		assert(i % 64 == 0 || record.asSlice(record.size() - 1).at(0) == static_cast<std::uint8_t>(i));
+		ring.release();
+	}
+
+	producer.join();
+}
+
+#if defined(__linux__)
+OHDEBUG_TEST("Mirrored ring buffer, contiguous regions across wraparound")
+{
+	Ut::Ct::MirroredRingBuffer<> ring{1000};
+	assert(ring.valid());
+	assert(ring.capacity() >= 1000);
+	const std::size_t chunkSize = ring.capacity() * 3 / 4;
+
+	for (std::size_t iChunk = 0; iChunk < 4; ++iChunk) {
+		auto writable = ring.writable().as<std::uint16_t>();
+		assert(writable.size() * sizeof(std::uint16_t) == ring.capacity());
+
+		for (std::size_t i = 0; i < chunkSize / sizeof(std::uint16_t); ++i) {
+			writable.data()[i] = static_cast<std::uint16_t>(i + iChunk);
+		}
+
+		ring.commit(chunkSize);
+		auto readable = ring.readable().as<const std::uint16_t>();
+		assert(readable.size() * sizeof(std::uint16_t) == chunkSize);
+
+		for (std::size_t i = 0; i < chunkSize / sizeof(std::uint16_t); ++i) {
+			assert(readable.data()[i] == static_cast<std::uint16_t>(i + iChunk));
+		}
+
+		ring.release(chunkSize);
+	}
+
+	int pipeFds[2];
+	assert(pipe(pipeFds) == 0);
+	const char kMessage[] = "0123456789";
+	assert(write(pipeFds[1], kMessage, sizeof(kMessage)) == sizeof(kMessage));
+	assert(ring.readFrom(pipeFds[0]) == sizeof(kMessage));
+	assert(ring.count() == sizeof(kMessage));
+	assert(memcmp(ring.readable().data(), kMessage, sizeof(kMessage)) == 0);
+	assert(ring.writeTo(pipeFds[1]) == sizeof(kMessage));
+	assert(ring.count() == 0);
+	char echo[sizeof(kMessage)] = {0};
+	assert(read(pipeFds[0], echo, sizeof(echo)) == sizeof(kMessage));
+	assert(memcmp(echo, kMessage, sizeof(kMessage)) == 0);
+	close(pipeFds[0]);
+	close(pipeFds[1]);
+
+	// More than the address space
+	Ut::Ct::MirroredRingBuffer<> unmapped{std::size_t{1} << 62};
+	assert(!unmapped.valid());
+	assert(unmapped.writable().data() == nullptr && unmapped.writable().size() == 0);
+	assert(unmapped.readable().data() == nullptr && unmapped.readable().size() == 0);
+}
+#endif
+
+OHDEBUG_TEST("Broadcast ring, lag policies")
+{
+	using Policy = Ut::Ct::BroadcastLagPolicy;
+	int value = 0;
+
+	{
+		Ut::Ct::BroadcastRing<int, 4, 2, Policy::Block> ring;
+		const auto fast = ring.subscribe();
+		const auto slow = ring.subscribe();
+		assert(ring.subscribe() == ring.kInvalidReader);
+
+		for (int i = 0; i < 4; ++i) {
+			assert(ring.tryPush(i));
+			assert(ring.tryPop(fast, value) && value == i);
+		}
+
+		assert(!ring.tryPush(4));  // The slow reader has not read anything yet
+		assert(ring.tryPop(slow, value) && value == 0);
+		assert(ring.tryPush(4));
+		assert(ring.count(slow) == 4);
+		ring.unsubscribe(slow);
+		assert(ring.tryPush(5));
+	}
+
+	{
+		Ut::Ct::BroadcastRing<int, 4, 2, Policy::DropOldest> ring;
+		const auto fast = ring.subscribe();
+		const auto slow = ring.subscribe();
+
+		for (int i = 0; i < 10; ++i) {
+			assert(ring.tryPush(i));
+			assert(ring.tryPop(fast, value) && value == i);
+		}
+
+		assert(ring.tryPop(slow, value));
+		OHDEBUG("Trace", "slow reader resumed from", value, "dropped", ring.dropped(slow));
+		assert(value == 7);
+		assert(ring.dropped(slow) == 7);
+		assert(ring.tryPop(slow, value) && value == 8);
+		assert(ring.tryPop(slow, value) && value == 9);
+		assert(!ring.tryPop(slow, value));
+		assert(ring.dropped(fast) == 0);
+	}
+
+	{
+		Ut::Ct::BroadcastRing<int, 4, 2, Policy::Skip> ring;
+		const auto fast = ring.subscribe();
+		const auto slow = ring.subscribe();
+
+		for (int i = 0; i < 6; ++i) {
+			assert(ring.tryPush(i));
+			assert(ring.tryPop(fast, value) && value == i);
+		}
+
+		assert(!ring.attached(slow));
+		assert(!ring.tryPop(slow, value));
+		ring.resubscribe(slow);
+		assert(ring.attached(slow));
+		assert(ring.dropped(slow) == 6);
+		assert(ring.tryPush(6));
+		assert(ring.tryPop(slow, value) && value == 6);
+	}
+}
+
+OHDEBUG_TEST("Broadcast ring, writer and reader threads")
+{
+	constexpr std::size_t kNitems = 1 << 14;
+	constexpr std::size_t kNreaders = 3;
+	Ut::Ct::BroadcastRing<std::size_t, 8, kNreaders> ring;
+	std::vector<std::thread> threads;
+	std::size_t readerIds[kNreaders];
+
+	for (auto &readerId : readerIds) {
+		readerId = ring.subscribe();
+		threads.emplace_back(
+			[&ring, readerId]()
+			{
+				for (std::size_t i = 0; i < kNitems; ++i) {
+					std::size_t value = 0;
+
+					while (!ring.tryPop(readerId, value)) {
+						std::this_thread::yield();
+					}
+
+					assert(value == i);
+				}
+			});
+	}
+
+	for (std::size_t i = 0; i < kNitems; ++i) {
+		while (!ring.tryPush(i)) {
+			std::this_thread::yield();
+		}
+	}
+
+	for (auto &thread : threads) {
+		thread.join();
+	}
+}
+
+OHDEBUG_TEST("Broadcast ring, subscribing while the writer runs")
+{
+	constexpr std::size_t kNsubscriptions = 200;
+	constexpr std::size_t kNreads = 64;
+	Ut::Ct::BroadcastRing<std::size_t, 8, 1> ring;
+	std::atomic<bool> done{false};
+	std::thread writer{
+		[&ring, &done]()
+		{
+			for (std::size_t i = 0; !done.load(); ) {
+				if (ring.tryPush(i)) {
+					++i;
+				}
+			}
+		}};
+
+	// Under `Block`, a reader must never be overwritten, even if it has attached in the middle of a push
+	for (std::size_t iSubscription = 0; iSubscription < kNsubscriptions; ++iSubscription) {
+		const std::size_t reader = ring.subscribe();
+		std::size_t previous = 0;
+
+		for (std::size_t iRead = 0; iRead < kNreads; ++iRead) {
+			std::size_t value = 0;
+
+			while (!ring.tryPop(reader, value)) {
+				std::this_thread::yield();
+			}
+
+			assert(iRead == 0 || value == previous + 1);
+			previous = value;
+		}
+
+		assert(ring.dropped(reader) == 0);
+		ring.unsubscribe(reader);
+	}
+
+	done.store(true);
+	writer.join();
+}
+
+/// Counting semaphore
+class Semaphore {
+public:
+	void release()
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+		++count;
+		conditionVariable.notify_one();
+	}
+
+	void acquire()
+	{
+		std::unique_lock<std::mutex> lock{mutex};
+		conditionVariable.wait(lock, [this]() {return count > 0;});
+		--count;
+	}
+
+	template <class TimeType>
+	bool tryAcquireFor(const TimeType &aTimeout)
+	{
+		std::unique_lock<std::mutex> lock{mutex};
+
+		if (conditionVariable.wait_for(lock, aTimeout, [this]() {return count > 0;})) {
+			--count;
+
+			return true;
+		}
+
+		return false;
+	}
+
+private:
+	std::mutex mutex;
+	std::condition_variable conditionVariable;
+	std::size_t count = 0;
+};
+
+OHDEBUG_TEST("Blocking queue")
+{
+	static constexpr std::size_t kNitems = 1 << 14;
+	Ut::Ct::BlockingFixedSizeQueue<std::size_t, 4, Semaphore> queue;
+	std::size_t value = 0;
+	assert(!queue.tryPopFor(value, std::chrono::milliseconds(10)));
+
+	std::thread producer{
+		[&queue]()
+		{
+			for (std::size_t i = 0; i < kNitems; ++i) {
+				queue.push(i);
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			queue.push(kNitems);
+		}};
+
+	for (std::size_t i = 0; i < kNitems; ++i) {
+		queue.pop(value);
+		assert(value == i);
+	}
+
+	assert(queue.tryPopFor(value, std::chrono::seconds(5)));
+	assert(value == kNitems);
+	producer.join();
+
+	for (std::size_t i = 0; i < 4; ++i) {
+		assert(queue.tryPushFor(i, std::chrono::milliseconds(1)));
+	}
+
+	assert(!queue.tryPushFor(0, std::chrono::milliseconds(10)));
+}
+
+OHDEBUG_TEST("Blocking queue, timed wait with a coarse unit")
+{
+	Ut::Ct::BlockingFixedSizeQueue<std::size_t, 4, Semaphore> queue;
+	std::size_t value = 0;
+	const auto start = std::chrono::steady_clock::now();
+	assert(!queue.tryPopFor(value, std::chrono::seconds(1)));
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	assert(elapsed >= std::chrono::milliseconds(990) && elapsed < std::chrono::seconds(5));
+}
+
+/// Every wait is woken up by a signal, but another consumer always takes the
+/// element first, i.e. every wake-up is a lost race
+struct LosingSemaphore {
+	void release()
+	{
+	}
+
+	void acquire()
+	{
+	}
+
+	template <class TimeType>
+	bool tryAcquireFor(const TimeType &aTimeout)
+	{
+		std::this_thread::sleep_for(std::min<TimeType>(aTimeout, std::chrono::milliseconds(5)));
+
+		return true;
+	}
+};
+
+OHDEBUG_TEST("Blocking queue, timed wait keeps the deadline")
+{
+	Ut::Ct::BlockingFixedSizeQueue<std::size_t, 4, LosingSemaphore> queue;
+	std::size_t value = 0;
+	const auto start = std::chrono::steady_clock::now();
+	assert(!queue.tryPopFor(value, std::chrono::milliseconds(20)));
+	assert(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+
+	for (std::size_t i = 0; i < 4; ++i) {
+		queue.tryPush(i);
+	}
+
+	assert(!queue.tryPushFor(0, std::chrono::milliseconds(20)));
+}
+
+OHDEBUG_TEST("Queue statistics")
+{
+	static_assert(sizeof(Ut::Ct::FixedSizeQueue<int, 4>) == sizeof(Ut::Ct::FixedSizeQueue<int, 4,
+		Ut::Ct::PlainQueueCursors, Ut::Ct::NoQueueStatistics>), "");
+	using Statistics = Ut::Ct::QueueStatistics<8>;
+	Ut::Ct::FixedSizeQueue<int, 8, Ut::Ct::PlainQueueCursors, Statistics> queue;
+
+	for (int i = 0; i < 10; ++i) {
+		queue.forcePush(i);
+	}
+
+	assert(!queue.tryPush(10));
+	assert(!queue.tryEmplace(10));
+	assert(queue.tryReserve() == nullptr);
+	int output[8] = {0};
+	assert(queue.tryPopN(output, 3) == 3);
+	assert(queue.tryPushN(output, 3) == 3);
+	assert(queue.tryPushN(output, 2) == 0);
+	std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+	while (queue.tryPopN(output, 8) > 0) {
+	}
+
+	const auto snapshot = queue.statistics().snapshot();
+	assert(snapshot.peakCount == 8);
+	assert(snapshot.nForcedDrops == 2);
+	assert(snapshot.nFailedPushes == 5);
+	std::size_t nResident = 0;
+	std::size_t nSlow = 0;
+
+	for (std::size_t i = 0; i < snapshot.residency.size(); ++i) {
+		nResident += snapshot.residency[i];
+		nSlow += i > 10 ? snapshot.residency[i] : 0;  // 1024 us and longer
+	}
+
+	assert(nResident == 11);  // Dropped ones are not accounted
+	assert(nSlow == 8);
+	OHDEBUG("Trace", "residency, slow", nSlow, "total", nResident);
+}
+
+OHDEBUG_TEST("SPSC queue statistics, snapshot from a third thread")
+{
+	constexpr std::size_t kNitems = 1 << 14;
+	Ut::Ct::SpscFixedSizeQueue<std::size_t, 8, Ut::Ct::QueueStatistics<8>> queue;
+	std::atomic<bool> done{false};
+	std::thread producer{
+		[&queue]()
+		{
+			for (std::size_t i = 0; i < kNitems; ++i) {
+				while (!queue.tryPush(i)) {
+					std::this_thread::yield();
+				}
+			}
+		}};
+	std::thread monitor{
+		[&queue, &done]()
+		{
+			while (!done.load()) {
+				assert(queue.statistics().snapshot().peakCount <= 8);
+				std::this_thread::yield();
+			}
+		}};
+	std::size_t value = 0;
+
+	for (std::size_t i = 0; i < kNitems; ++i) {
+		while (!queue.tryPop(value)) {
+			std::this_thread::yield();
+		}
+	}
+
+	producer.join();
+	done.store(true);
+	monitor.join();
+	const auto snapshot = queue.statistics().snapshot();
+	std::size_t nResident = 0;
+
+	for (auto n : snapshot.residency) {
+		nResident += n;
+	}
+
+	assert(nResident == kNitems);
+	assert(snapshot.peakCount > 0 && snapshot.peakCount <= 8);
+}
+
+OHDEBUG_TEST("Priority queue, against std::priority_queue")
+{
+	constexpr std::size_t kCapacity = 37;
+	Ut::Ct::FixedSizePriorityQueue<int, kCapacity> queue;
+	std::priority_queue<int> reference;
+	std::mt19937 generator{7};
+	assert(queue.top() == nullptr);
+
+	for (std::size_t i = 0; i < 1 << 14; ++i) {
+		if (generator() % 3 != 0) {
+			const int value = static_cast<int>(generator() % 100);
+			assert(queue.tryPush(value) == (reference.size() < kCapacity));
+
+			if (reference.size() < kCapacity) {
+				reference.push(value);
+			}
+		} else {
+			int value = -1;
+			assert(queue.tryPop(value) == !reference.empty());
+
+			if (!reference.empty()) {
+				assert(value == reference.top());
+				reference.pop();
+			}
+		}
+
+		assert(queue.count() == reference.size());
+		assert(reference.empty() || *queue.top() == reference.top());
+	}
+}
+
+OHDEBUG_TEST("Priority queue, non-default-constructible elements")
+{
+	struct Command {
+		Command(int aPriority, std::string aName) : priority{aPriority}, name{std::move(aName)}
+		{
+		}
+
+		int priority;
+		std::string name;
+	};
+	struct Urgent {
+		bool operator()(const Command &aLhs, const Command &aRhs) const
+		{
+			return aLhs.priority < aRhs.priority;
+		}
+	};
+	Ut::Ct::FixedSizePriorityQueue<Command, 4, Urgent> queue;
+	assert(queue.tryEmplace(1, "telemetry"));
+	assert(queue.tryEmplace(5, "set mode"));
+	assert(queue.tryPush(Command{100, "emergency stop"}));
+	assert(queue.tryEmplace(1, "log"));
+	assert(!queue.tryEmplace(0, "overflow"));
+	assert(queue.top()->name == "emergency stop");
+	Command command{0, ""};
+	assert(queue.tryPop(command) && command.name == "emergency stop");
+	assert(queue.tryPop(command) && command.name == "set mode");
+	assert(queue.tryPop(command) && command.priority == 1);
+	assert(queue.count() == 1);
+}
+
+OHDEBUG_TEST("Move-only elements, consume in place")
+{
+	static int nAlive = 0;
+	struct Handle {
+		Handle(int aValue) : value{aValue}
+		{
+			++nAlive;
+		}
+
+		~Handle()
+		{
+			--nAlive;
+		}
+
+		int value;
+	};
+	{
+		Ut::Ct::FixedSizeQueue<std::unique_ptr<Handle>, 4> queue;
+
+		for (int i = 0; i < 6; ++i) {
+			queue.forcePush(std::unique_ptr<Handle>{new Handle{i}});
+		}
+
+		assert(nAlive == 4);
+		assert(!queue.tryPush(std::unique_ptr<Handle>{new Handle{6}}));
+		assert(nAlive == 4);
+		assert(queue.tryConsume([](std::unique_ptr<Handle> &aHandle) {assert(aHandle->value == 2);}));
+		assert(nAlive == 3);
+		std::unique_ptr<Handle> taken;
+		assert(queue.tryConsume([&taken](std::unique_ptr<Handle> &aHandle) {taken = std::move(aHandle);}));
+		assert(taken->value == 3 && nAlive == 3);
+		assert(queue.tryPop(taken) && taken->value == 4);
+		assert(nAlive == 2);
+		queue.forceEmplace(new Handle{7});
+	}
+	assert(nAlive == 0);  // The queue destroys the remaining elements
+
+	Ut::Ct::FixedSizeQueue<std::string, 4> original;
+	original.forcePush("first");
+	original.forcePush(std::string(64, 'x'));
+	Ut::Ct::FixedSizeQueue<std::string, 4> copy{original};
+	copy = original;
+	std::string value;
+	assert(original.tryPop(value) && value == "first");
+	assert(copy.count() == 2);
+	assert(copy.tryConsume([](std::string &aValue) {assert(aValue == "first");}));
+	assert(copy.tryPop(value) && value.size() == 64);
+	assert(!copy.tryConsume([](std::string &) {assert(false);}));
+}
+
 int main(void)
 {
 	OHDEBUG_RUN_TESTS();
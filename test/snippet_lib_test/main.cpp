@@ -6,11 +6,16 @@
 	"Trace", \
 	"Test"
 
+#include <algorithm>
 #include <iostream>
 #include <mutex>
+#include <random>
 #include <thread>
+#include <tuple>
+#include <vector>
 #include "utility/snippet/NothrowFuture.hpp"
 #include "utility/snippet/LongRequestQueue.hpp"
+#include "utility/snippet/ShardedLongRequestQueue.hpp"
 
 using PromiseType = Ut::Sn::Promise<int, std::mutex>;
 using FutureType = Ut::Sn::Future<int, std::mutex>;
@@ -103,6 +108,350 @@ OHDEBUG_TEST("Long request queue")
 	std::cout << "Done" << std::endl;
 }
 
+/// Records handler calls as (time, identifier, expired)
+struct RecordingRequestHandler : public Ut::Sn::RequestHandler<Request> {
+	using Event = std::tuple<TimeType, std::size_t, bool>;
+
+	void retryRequest(const Request &aRequest) override
+	{
+		events.emplace_back(now, aRequest.identifier, false);
+	}
+
+	void onRequestExpired(const Request &aRequest) override
+	{
+		events.emplace_back(now, aRequest.identifier, true);
+	}
+
+	TimeType now = 0;
+	std::vector<Event> events;
+};
+
+template <template <class, class, std::size_t> class StorageType>
+using StorageLongRequestQueueType = Ut::Sn::LongRequestQueue<Request, MutexType, TimeType, 4, StorageType>;
+
+OHDEBUG_TEST("Long request queue, timer wheel storage matches vector storage")
+{
+	StorageLongRequestQueueType<Ut::Sn::LongRequestVectorStorage> vectorQueue;
+	StorageLongRequestQueueType<Ut::Sn::LongRequestTimerWheelStorage> wheelQueue;
+	static StorageLongRequestQueueType<Ut::Sn::LongRequestFixedStorage<4096>::Storage> fixedQueue;
+	RecordingRequestHandler vectorHandler;
+	RecordingRequestHandler wheelHandler;
+	RecordingRequestHandler fixedHandler;
+	vectorQueue.setRequestHandler(vectorHandler);
+	wheelQueue.setRequestHandler(wheelHandler);
+	fixedQueue.setRequestHandler(fixedHandler);
+	std::mt19937 generator{1};
+	TimeType now = 1700000000000UL;  // Epoch-based milliseconds
+	std::size_t identifier = 0;
+	std::size_t nEvents = 0;
+	std::vector<std::tuple<Ut::Sn::LongRequestHandle, Ut::Sn::LongRequestHandle, Ut::Sn::LongRequestHandle>> handles;
+
+	for (std::size_t iStep = 0; iStep < 5000; ++iStep) {
+		// Steps from 1 ms up to a few minutes, so every level of the wheel gets involved
+		const unsigned scale = generator() % 4;
+		now += 1 + generator() % (scale == 0 ? 3 : scale == 1 ? 100 : scale == 2 ? 5000 : 300000);
+		vectorHandler.now = now;
+		wheelHandler.now = now;
+		fixedHandler.now = now;
+
+		for (unsigned iPush = generator() % 3; iPush > 0; --iPush) {
+			const TimeType timeout = generator() % 2 ? 1 + generator() % 200 : 1 + generator() % 1000000;
+			const std::size_t nAttempts = generator() % 4;
+			handles.emplace_back(vectorQueue.push({identifier}, timeout, nAttempts, now),
+				wheelQueue.push({identifier}, timeout, nAttempts, now),
+				fixedQueue.push({identifier}, timeout, nAttempts, now));
+			++identifier;
+		}
+
+		// ACKs, some of them arrive after the request has expired
+		for (unsigned iCancel = generator() % 3; iCancel > 0 && !handles.empty(); --iCancel) {
+			const std::size_t position = generator() % handles.size();
+			const bool isCancelled = vectorQueue.cancel(std::get<0>(handles[position]));
+			assert(wheelQueue.cancel(std::get<1>(handles[position])) == isCancelled);
+			assert(fixedQueue.cancel(std::get<2>(handles[position])) == isCancelled);
+			assert(!vectorQueue.cancel(std::get<0>(handles[position])));
+			assert(!wheelQueue.cancel(std::get<1>(handles[position])));
+			handles[position] = handles.back();
+			handles.pop_back();
+		}
+
+		if (generator() % 50 == 0) {
+			const std::size_t divisor = 2 + generator() % 5;
+			auto predicate = [divisor](Request &aRequest) { return aRequest.identifier % divisor == 0; };
+			vectorQueue.removeIf(predicate);
+			wheelQueue.removeIf(predicate);
+			fixedQueue.removeIf(predicate);
+		}
+
+		const TimeType vectorNextTimeout = vectorQueue.onTick(now);
+		const TimeType wheelNextTimeout = wheelQueue.onTick(now);
+		assert(fixedQueue.onTick(now) == wheelNextTimeout);
+		assert(vectorQueue.size() == wheelQueue.size());
+		assert(fixedQueue.size() == wheelQueue.size());
+
+		// The wheel may only wake the caller earlier
+		assert(vectorNextTimeout == 0 || (wheelNextTimeout > 0 && wheelNextTimeout <= vectorNextTimeout));
+
+		// Requests updated within a tick may be notified of in any order
+		std::sort(vectorHandler.events.begin(), vectorHandler.events.end());
+		std::sort(wheelHandler.events.begin(), wheelHandler.events.end());
+		std::sort(fixedHandler.events.begin(), fixedHandler.events.end());
+		assert(vectorHandler.events == wheelHandler.events);
+		assert(fixedHandler.events == wheelHandler.events);
+		nEvents += vectorHandler.events.size();
+		vectorHandler.events.clear();
+		wheelHandler.events.clear();
+		fixedHandler.events.clear();
+	}
+
+	assert(nEvents > 10000);
+	assert(fixedQueue.overflowCount() == 0);
+}
+
+template <template <class, class, std::size_t> class StorageType>
+static void testLongRequestCancellation()
+{
+	StorageLongRequestQueueType<StorageType> queue;
+	RecordingRequestHandler handler;
+	queue.setRequestHandler(handler);
+	const auto first = queue.push({1}, 10, 1, 0);
+	const auto second = queue.push({2}, 10, 0, 0);
+	assert(queue.size() == 2);
+	assert(!queue.cancel(Ut::Sn::LongRequestHandle{}));
+	assert(queue.cancel(first));
+	assert(!queue.cancel(first));
+	assert(queue.size() == 1);
+
+	// The slot gets reused, the stale handle must not cancel the new request
+	const auto third = queue.push({3}, 10, 1, 0);
+	assert(!queue.cancel(first));
+	assert(queue.size() == 2);
+
+	// Expired requests may not be cancelled
+	queue.onTick(1);
+	assert(queue.size() == 1);
+	assert(!queue.cancel(second));
+	assert(queue.cancel(third));
+	assert(queue.size() == 0);
+	queue.onTick(100);
+	assert(handler.events.size() == 4);  // Three initial attempts, and one expiration
+}
+
+OHDEBUG_TEST("Long request queue, cancellation by handle")
+{
+	testLongRequestCancellation<Ut::Sn::LongRequestVectorStorage>();
+	testLongRequestCancellation<Ut::Sn::LongRequestTimerWheelStorage>();
+	testLongRequestCancellation<Ut::Sn::LongRequestFixedStorage<4>::Storage>();
+}
+
+template <template <class, class, std::size_t> class StorageType>
+static void testLongRequestDueTimeout()
+{
+	StorageLongRequestQueueType<StorageType> queue;
+	RecordingRequestHandler handler;
+	queue.setRequestHandler(handler);
+	queue.push({1}, 10, 1, 0);
+	assert(queue.onTick(10) == 1);  // Due, but retried only once the timeout is exceeded
+	assert(handler.events.size() == 1);
+	assert(queue.onTick(11) == 10);
+	assert(handler.events.size() == 2);
+	assert(queue.onTick(22) == 0);
+	assert(queue.size() == 0);
+
+	// A zero timeout does not report the queue as idle either
+	queue.push({2}, 0, 1, 30);
+	assert(queue.onTick(30) == 1);
+	assert(queue.onTick(31) == 1);
+	assert(handler.events.size() == 5);
+	assert(queue.onTick(32) == 0);
+	assert(handler.events.size() == 6 && std::get<2>(handler.events.back()));  // Expired
+}
+
+OHDEBUG_TEST("Long request queue, due requests report a timeout of 1")
+{
+	testLongRequestDueTimeout<Ut::Sn::LongRequestVectorStorage>();
+	testLongRequestDueTimeout<Ut::Sn::LongRequestTimerWheelStorage>();
+	testLongRequestDueTimeout<Ut::Sn::LongRequestFixedStorage<4>::Storage>();
+}
+
+OHDEBUG_TEST("Long request queue, fixed capacity")
+{
+	StorageLongRequestQueueType<Ut::Sn::LongRequestFixedStorage<4>::Storage> queue;
+	RecordingRequestHandler handler;
+	queue.setRequestHandler(handler);
+	std::vector<Ut::Sn::LongRequestHandle> handles;
+
+	for (std::size_t i = 0; i < 4; ++i) {
+		handles.push_back(queue.push({i}, 10, 1, 0));
+		assert(handles.back().isValid());
+	}
+
+	// Rejected requests are neither tried, nor stored
+	const auto rejected = queue.push({4}, 10, 1, 0);
+	assert(!rejected.isValid());
+	assert(!queue.cancel(rejected));
+	assert(!queue.push({5}, 10, 1, 0).isValid());
+	assert(queue.overflowCount() == 2);
+	assert(queue.size() == 4);
+	assert(handler.events.size() == 4);
+
+	// Freed nodes are reused, cancelled, expired, or removed ones alike
+	assert(queue.cancel(handles[0]));
+	handles[0] = queue.push({6}, 10, 0, 0);
+	assert(handles[0].isValid());
+	assert(!queue.push({7}, 10, 0, 0).isValid());
+	queue.removeIf([](Request &aRequest) { return aRequest.identifier == 1; });
+	assert(queue.push({8}, 10, 0, 0).isValid());
+	queue.onTick(11);  // Retries 2, 3, expires 6, 8
+	assert(queue.size() == 2);
+	assert(queue.push({9}, 10, 0, 0).isValid());
+	assert(queue.push({10}, 10, 0, 0).isValid());
+	assert(queue.size() == 4);
+	assert(queue.overflowCount() == 3);
+}
+
+using OutsideLockLongRequestQueueType = Ut::Sn::LongRequestQueue<Request, MutexType, TimeType, 4,
+	Ut::Sn::LongRequestTimerWheelStorage, Ut::Sn::LongRequestDispatch::OutsideLock>;
+
+/// ACKs every retried request from within the callback, which would
+/// deadlock, if the queue was still locked
+struct ReentrantRequestHandler : public Ut::Sn::RequestHandler<Request> {
+	void retryRequests(Ut::Ct::Buffer<const Request> aRequests) override
+	{
+		batchSizes.push_back(aRequests.size());
+
+		for (const Request &request : aRequests) {
+			if (request.identifier % 2 == 0) {
+				assert(queue->cancel(handles[request.identifier]));
+			}
+		}
+
+		handles.push_back(queue->push({handles.size()}, 1000, 1, 0));
+	}
+
+	void onRequestsExpired(Ut::Ct::Buffer<const Request> aRequests) override
+	{
+		nExpired += aRequests.size();
+	}
+
+	OutsideLockLongRequestQueueType *queue;
+	std::vector<Ut::Sn::LongRequestHandle> handles;
+	std::vector<std::size_t> batchSizes;
+	std::size_t nExpired = 0;
+};
+
+OHDEBUG_TEST("Long request queue, dispatch outside the lock")
+{
+	OutsideLockLongRequestQueueType queue;
+	ReentrantRequestHandler handler;
+	handler.queue = &queue;
+
+	for (std::size_t i = 0; i < 10; ++i) {
+		handler.handles.push_back(queue.push({i}, 100, 2, 0));
+	}
+
+	queue.setRequestHandler(handler);
+	assert(queue.onTick(50) > 0);
+	assert(handler.batchSizes.empty());
+	queue.onTick(101);
+	assert((handler.batchSizes == std::vector<std::size_t>{10}));
+	assert(queue.size() == 6);  // 5 ACKed, 1 pushed from the callback
+	queue.onTick(202);
+	assert((handler.batchSizes == std::vector<std::size_t>{10, 5}));
+	queue.onTick(203);  // The 5 unACKed ones have used all their attempts
+	assert(handler.nExpired == 5);
+	assert(queue.size() == 2);
+}
+
+using ShardedLongRequestQueueType = Ut::Sn::ShardedLongRequestQueue<Request, std::chrono::milliseconds, 4,
+	Ut::Sn::LongRequestTimerWheelStorage>;
+
+/// Records the moments of retries, invoked from both the pushing thread, and
+/// the shard's worker
+struct TimingRequestHandler : public Ut::Sn::RequestHandler<Request> {
+	void retryRequest(const Request &aRequest) override
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+		retries.emplace_back(aRequest.identifier, queue->now());
+	}
+
+	void onRequestExpired(const Request &) override
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+		++nExpired;
+	}
+
+	ShardedLongRequestQueueType *queue;
+	std::mutex mutex;
+	std::vector<std::pair<std::size_t, std::chrono::milliseconds>> retries;
+	std::size_t nExpired = 0;
+};
+
+OHDEBUG_TEST("Long request queue, sharded")
+{
+	constexpr std::size_t kNlinks = 8;
+	constexpr std::chrono::milliseconds kTimeout{20};
+	ShardedLongRequestQueueType queue{kNlinks, 3};
+	std::vector<TimingRequestHandler> handlers(kNlinks);
+
+	for (std::size_t link = 0; link < kNlinks; ++link) {
+		handlers[link].queue = &queue;
+		queue.setRequestHandler(link, handlers[link]);
+	}
+
+	queue.start();
+
+	// The workers are idle by now, pushes must wake them up
+	std::this_thread::sleep_for(std::chrono::milliseconds{10});
+	std::vector<Ut::Sn::LongRequestHandle> handles;
+
+	for (std::size_t link = 0; link < kNlinks; ++link) {
+		handles.push_back(queue.push(link, {0}, kTimeout, 2));
+		queue.push(link, {1}, kTimeout * (link + 1), 0);
+	}
+
+	assert(queue.cancel(1, handles[1]));
+
+	// Every request expires in about `kTimeout * kNlinks`, the bound is for a loaded machine
+	auto isDone = [&]()
+	{
+		for (std::size_t link = 0; link < kNlinks; ++link) {
+			std::lock_guard<std::mutex> lock{handlers[link].mutex};
+
+			if (handlers[link].nExpired < (link == 1 ? 1 : 2)) {
+				return false;
+			}
+		}
+
+		return true;
+	};
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+
+	while (!isDone() && std::chrono::steady_clock::now() < deadline) {
+		std::this_thread::sleep_for(std::chrono::milliseconds{5});
+	}
+
+	queue.stop();
+
+	for (std::size_t link = 0; link < kNlinks; ++link) {
+		TimingRequestHandler &handler = handlers[link];
+		assert(queue.size(link) == 0);
+		assert(handler.nExpired == (link == 1 ? 1 : 2));
+
+		// The initial attempt, and 2 retries. The last one is about 2 timeouts after the first one
+		std::vector<std::chrono::milliseconds> moments;
+
+		for (const auto &retry : handler.retries) {
+			if (retry.first == 0) {
+				moments.push_back(retry.second);
+			}
+		}
+
+		assert(moments.size() == (link == 1 ? 1 : 3));
+		assert(link == 1 || moments.back() - moments.front() >= kTimeout * 2);
+	}
+}
+
 int main(void)
 {
 	OHDEBUG_RUN_TESTS();